@@ -1,13 +1,34 @@
 #pragma once
 
+#include <cache/dense_index.h>
+#include <cache/eviction_options.h>
+#include <cache/hash.h>
+#include <cache/hash_index.h>
 #include <cache/item_factory.h>
+#include <cache/item_options.h>
 #include <cache/lock_policy.h>
+#include <cache/sharding_options.h>
+#include <cache/snapshot.h>
+#include <cache/statistics.h>
 #include <cache/update_hook.h>
 
+#include <utility/epoch.h>
+#include <utility/lock_profile.h>
+#include <utility/numa.h>
+#include <utility/sharded_counters.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace cache
 {
@@ -15,10 +36,25 @@ namespace cache
   /**
    * \class Cache
    * \brief Least-recently used cache
+   * \details The cache may be split into shards (see ShardingOptions), each with its own lock, index and recency
+   * queue, so lookups of keys in different shards do not contend
    * \tparam KeyType - type of keys used for object referencing
    * \tparam ValueType - type of stored objects
+   * \tparam UpdateHookType - type of the noexcept function object executed on dirty items leaving the cache
+   * (see UpdateHook for requirements). The hook is stored once per cache; stateless hooks take no space in items
+   * \tparam IndexPolicy - selects the index of items by key: HashIndexPolicy for any hashable key, or
+   * DenseIndexPolicy for dense non-negative integral keys (e.g. line numbers), which are looked up by offset.
+   * The policy also selects the shard of a key (IndexPolicy::shard_hash): by hash, or by page of a dense index
+   * \tparam HashType - default-constructible hash function of keys, selecting their shard and their bucket in hash indexes. The hash of a key
+   * is computed once per operation and stored in its entry, so evictions and rehashes do not hash keys again
    */
-  template <typename KeyType, typename ValueType>
+  template <
+    typename KeyType, 
+    typename ValueType, 
+    typename UpdateHookType = UpdateHook<KeyType, ValueType>, 
+    typename IndexPolicy = HashIndexPolicy,
+    typename HashType = Hash<KeyType>
+  >
   class Cache
   {
   public:
@@ -29,37 +65,136 @@ namespace cache
     using ItemPtr = std::shared_ptr<Item<ValueType>>;
 
   private:
-    struct ItemInfo
+    struct Entry : private UpdateHookRef<UpdateHookType>
     {
-      KeyType key;
-      ItemPtr item;
+      Entry(
+        const KeyType& key, 
+        size_t hash,
+        std::unique_ptr<Item<ValueType>>&& item, 
+        const std::shared_ptr<const UpdateHookType>& updateHook
+      );
+
+      /**
+       * \brief Executes the update hook in case the item is dirty
+       */
+      ~Entry();
+
+      const KeyType key;
+      const size_t hash;
+      const std::unique_ptr<Item<ValueType>> item;
+      UpdateReason reason;
+      std::atomic<bool> unlinked;
+      bool protectedSegment; ///< guarded by the lock of the shard
+      size_t scanned;        ///< id of the last scan of the shard visiting the entry, guarded by the lock of the shard
     };
 
-    using ItemQueue = std::list<ItemInfo>;
+    using EntryPtr = std::shared_ptr<Entry>;
+    using ItemQueue = std::list<EntryPtr, utility::NumaAllocator<EntryPtr>>;
     using ItemIter = typename ItemQueue::iterator;
-    using ItemMap = std::unordered_map<KeyType, ItemIter>;
+    using ItemMap = typename IndexPolicy::template Index<KeyType, ItemIter, utility::NumaAllocator<ItemIter>>;
+    using Mutex = utility::ProfiledMutex<std::mutex>;
+    using Clock = std::chrono::steady_clock;
+    using AbsentMap = std::unordered_map<
+      KeyType, 
+      Clock::time_point, 
+      HashType, 
+      std::equal_to<KeyType>, 
+      utility::NumaAllocator<std::pair<const KeyType, Clock::time_point>>
+    >;
+
+    struct Shard
+    {
+      /**
+       * \param arena - arena the index and queue nodes are allocated in, or null to use the global operator new
+       */
+      Shard(size_t size, size_t node, const std::shared_ptr<utility::NumaArena>& arena);
+
+      size_t size;
+      const size_t node;
+      const std::shared_ptr<utility::NumaArena> arena;
+      ItemQueue queue;        ///< protected items followed by probationary ones, from the most to the least recently used
+      ItemIter probation;     ///< first probationary item in the queue
+      size_t protectedSize;   ///< maximum number of protected items
+      size_t protectedCount;
+      ItemMap map;
+      AbsentMap absent; ///< keys known to be absent, with their expiry times
+      ItemIter cursor;  ///< item visited last by the running scan, or the end of the queue
+      size_t scanId;    ///< id of the running or last scan
+      size_t unscanned; ///< number of items in the queue the running scan has yet to visit
+      Mutex mutex;
+    };
+
+    using ShardPtr = std::shared_ptr<Shard>;
+
+  public:
+    /**
+     * \class Guard
+     * \brief Pin of the epoch of the cache, keeping borrowed items alive (see borrow)
+     */
+    using Guard = utility::EpochDomain::Guard;
+
+    /**
+     * \class Handle
+     * \brief Pointer to an item together with a view of whether the item is still in the cache
+     * \details Lets callers keep items across lookups (see FrontCache) and detect their eviction without locking
+     */
+    class Handle
+    {
+    public:
+      /**
+       * \brief Constructs an empty handle
+       */
+      Handle() noexcept;
+
+      /**
+       * \brief Returns the pointer to the item, or null for an empty handle
+       */
+      const ItemPtr& item() const noexcept;
+
+      /**
+       * \brief Returns true if the item has not left the cache since the lookup
+       * \details Once false, a lookup of the same key creates or finds another item
+       */
+      bool linked() const noexcept;
+
+    private:
+      friend class Cache;
+
+      Handle(ItemPtr&& item, const std::atomic<bool>* unlinked) noexcept;
+
+    private:
+      ItemPtr m_item;
+      const std::atomic<bool>* m_unlinked;
+    };
 
   public:
     /**
      * \brief Constructor
-     * \details updateHook is executed on destruction of the last pointer to each item
+     * \details updateHook is executed on destruction of the last pointer to each item modified (marked dirty)
+     * while in the cache. Clean items are dropped without executing updateHook
      * \param size - size (in objects) of the cache
-     * \param updateHook - function object satisfying UpdateHook requirements
-     * \param writeHeavy - if true, WriteHeavyLockPolicy will be used in items
-     * \param if false, ReadHeavyLockPolicy will be used in items
+     * \param updateHook - function object UpdateHookType is constructible from
+     * \param items - implementation of items: a bool converts to the writeHeavy flag (WriteHeavyLockPolicy if true,
+     * ReadHeavyLockPolicy if false), and rcu selects RcuItem for values without lock-free atomic operations
      * \param defaultValue - value stored in an item until it is first written
+     * \param sharding - number of shards and their placement on NUMA nodes
+     * \param eviction - eviction policy
+     * \throw if size is 0 or smaller than the number of shards, or the protected ratio is out of [0, 1)
      */
     template <typename UpdateHookFwd>
     Cache(
       size_t size, 
       UpdateHookFwd&& updateHook, 
-      bool writeHeavy = false,
-      const ValueType& defaultValue = ValueType()
+      const ItemOptions& items = ItemOptions(),
+      const ValueType& defaultValue = ValueType(),
+      const ShardingOptions& sharding = ShardingOptions(),
+      const EvictionOptions& eviction = EvictionOptions()
     );
 
     /**
      * \brief Returns a shared pointer to the item for a given key
-     * \details If an item exists for the key, it will be moved to the back of the remove queue
+     * \details If an item exists for the key, it will be moved to the back of the remove queue of its shard
+     * (of the protected segment in a segmented cache, see EvictionOptions)
      * and a pointer to it will be returned.
      * If the item does not exist, a new item will be created in the back of the remove queue
      * and a pointer to it will be returned. 
@@ -67,21 +202,351 @@ namespace cache
      * pointer item will be extended by the shared pointer.
      */
     ItemPtr operator[](const KeyType& key); 
+
+    /**
+     * \brief Same as operator[], except null is returned without creating an item if the key is known to be absent
+     * \details See mark_absent. Known absence is only checked on misses, so lookups of cached items cost the same
+     */
+    ItemPtr get(const KeyType& key);
+
+    /**
+     * \brief Same as operator[], but returns a handle to the item
+     * \param skipAbsent - if true, an empty handle is returned for a key known to be absent (see get)
+     */
+    Handle lookup(const KeyType& key, bool skipAbsent = false);
+
+    /**
+     * \brief Runs a function object on the item for a given key if it is in the cache
+     * \details The item is touched as by operator[], and visitor runs under the lock of its shard, so the item
+     * cannot be evicted meanwhile and no shared pointer is copied: hot items are read without updating their
+     * reference counts from multiple threads. visitor should be short (e.g. a read) and must not access the cache,
+     * as the other keys of the shard are blocked while it runs; items should be written through operator[] instead.
+     * Known absences are not checked
+     * \param key - key of the item
+     * \param visitor - function object taking Item<ValueType>& as argument
+     * \return true if the item was found and visited
+     */
+    template <typename Visitor>
+    bool visit(const KeyType& key, Visitor&& visitor);
+
+    /**
+     * \brief Same as visit, except the item is created if it is not in the cache (see operator[])
+     * \return result of visitor
+     */
+    template <typename Visitor>
+    decltype(auto) visit_or_create(const KeyType& key, Visitor&& visitor);
+
+    /**
+     * \brief Pins the epoch of the cache for the calling thread
+     * \details Items borrowed under the guard stay alive until it is destroyed. Guards should be short-lived,
+     * as evicted items are not released (and the update hook is not executed on them) while older guards exist.
+     * Guards must be destroyed before the cache
+     * \throw if the cache does not use epoch-based reclamation (see EvictionOptions)
+     */
+    Guard pin() const;
+
+    /**
+     * \brief Same as operator[], but returns a raw pointer to the item valid until guard is destroyed
+     * \details No shared pointer is copied, so hot items are read without updating their reference counts
+     * from multiple threads
+     * \param guard - pin of the epoch of the cache (see pin)
+     * \param skipAbsent - if true, null is returned for a key known to be absent (see get)
+     * \throw if guard does not pin the epoch of the cache
+     */
+    Item<ValueType>* borrow(const KeyType& key, const Guard& guard, bool skipAbsent = false);
+
+    /**
+     * \brief Releases the evicted items which no guard can reference anymore
+     * \details The update hook is executed on released items written to since their eviction. Evicted items
+     * are also released in batches as items are evicted, so this is only needed to release memory early
+     * \return number of released items, always 0 without epoch-based reclamation
+     */
+    size_t reclaim();
+
+    /**
+     * \brief Records that no value exists for a key, so that get returns null for it without a load
+     * \details A clean item of the key is dropped from the cache, while a dirty one (i.e. a value was written)
+     * is kept and the absence is not recorded. Known absences do not occupy item slots: each shard keeps up to as
+     * many absent keys as items, expired ones being dropped when it is full, or all of them if none expired.
+     * Creating an item for the key (operator[], insert) clears its absence
+     * \param key - key known to be absent
+     * \param ttl - time after which the absence expires, or 0 if it never does
+     * \return true if the absence was recorded
+     */
+    bool mark_absent(const KeyType& key, std::chrono::milliseconds ttl = std::chrono::milliseconds::zero());
+
+    /**
+     * \brief Returns true if a key is known to be absent (see mark_absent)
+     */
+    bool absent(const KeyType& key);
+
+    /**
+     * \brief Removes the item for a given key from the cache, if any, and its known absence
+     * \details The item is released (see EvictionOptions) with UpdateReason::Erased after the lock is released.
+     * Pointers to the item remain valid, while handles to it report it unlinked
+     * \param key - key of the item
+     * \param flush - if true, the update hook is executed on the item if dirty; if false, its modifications are dropped
+     * \return true if an item was removed
+     */
+    bool erase(const KeyType& key, bool flush = true);
+
+    /**
+     * \brief Removes the items matching a predicate from the cache (see erase)
+     * \details The items of a shard are walked from the least to the most recently used, a small number at a time
+     * under its lock, so lookups proceed while erasing, and removed items are released outside of the lock.
+     * Every item in the cache when the walk of its shard starts and still there when reached is tested once, even if
+     * it is looked up meanwhile; items added concurrently are skipped. Concurrent calls and flushes are serialized
+     * \param predicate - function object taking const KeyType& and const Item<ValueType>& as arguments and returning
+     * true for items to remove. It runs under the lock of a shard, so it should be short and must not access the cache
+     * \param flush - if true, the update hook is executed on removed dirty items
+     * \return number of removed items
+     */
+    template <typename Predicate>
+    size_t erase_if(Predicate&& predicate, bool flush = true);
+
+    /**
+     * \brief Removes all items and known absences from the cache (see erase)
+     * \details Each shard is emptied under its lock at once, one shard after another, and its items are released
+     * outside of the lock, so lookups of other shards proceed meanwhile
+     * \param flush - if true, the update hook is executed on removed dirty items
+     * \return number of removed items
+     */
+    size_t clear(bool flush = true);
+
+    /**
+     * \brief Inserts clean items for keys absent from the cache
+     * \details Items are created before the cache is locked and linked in with a single lock acquisition,
+     * per shard, which is much cheaper than populating items one by one through operator[]. Inserted items become
+     * the most recently used, in the order of the range, evicting the least recently used items if their shard is full.
+     * Items already in the cache (including duplicates within the range) are left untouched
+     * \param first - iterator to the first element of a range of pairs of keys and values
+     * \param last - iterator past the last element of the range
+     * \return number of inserted items
+     */
+    template <typename InputIterator>
+    size_t insert(InputIterator first, InputIterator last);
+
+    /**
+     * \brief Loads items for a set of keys into the cache in parallel
+     * \details Keys are split into threadCount contiguous parts, each loaded by a single call to loader on a
+     * separate thread (e.g. a single pass over a file) and inserted in batches (see insert). Only as many
+     * first keys are loaded as there is free space in the cache, so loaded items do not evict each other or the
+     * items already in the cache, unless keys are spread unevenly over shards
+     * \param keys - keys to load in the order loader expects them (e.g. ascending positions in a file)
+     * \param loader - threadsafe function object taking const std::vector<KeyType>& as argument and returning
+     * std::vector<ValueType> with the values of the keys; fewer values may be returned (e.g. at the end of a file),
+     * in which case the remaining keys are not loaded
+     * \param threadCount - number of loading threads
+     * \param batchSize - maximum number of items inserted per lock acquisition
+     * \return number of inserted items
+     * \throw if loader throws or returns more values than keys
+     */
+    template <typename Loader>
+    size_t warm_up(const std::vector<KeyType>& keys, Loader&& loader, size_t threadCount, size_t batchSize = 256);
+
+    /**
+     * \brief Executes the update hook on all dirty items without removing them from the cache
+     * \details Items are cleaned before the hook is executed with UpdateReason::Flushed, so items modified
+     * concurrently will be flushed again later. The items of a shard are walked a batch at a time under its lock,
+     * and the hook is executed outside of the lock, so lookups proceed while flushing. Every item dirty when the walk
+     * of its shard starts is flushed, even if it is looked up meanwhile; items made dirty later may be left to the
+     * next flush. Concurrent flushes are serialized
+     * \return number of flushed items
+     */
+    size_t flush();
+
+    /**
+     * \brief Passes all dirty items in batches to a function object without removing them from the cache
+     * \details Same as flush(), except a batch of items is passed to batchHook instead of executing the update
+     * hook on each item. Used to persist multiple items with a single write
+     * \param batchHook - noexcept function object taking std::vector<std::pair<KeyType, ValueType>>& as argument
+     * \param batchSize - maximum number of items passed to batchHook at once
+     * \return number of flushed items
+     */
+    template <typename BatchHook>
+    size_t flush(BatchHook&& batchHook, size_t batchSize = 256);
+
+    /**
+     * \brief Writes all items of the cache to a binary snapshot file
+     * \details Recency queues are copied under shard locks, while values are read and written outside of them.
+     * Items are saved shard by shard from the least to the most recently used together with their dirty flags, keys and values
+     * being encoded with SnapshotCodec. The snapshot is written to a temporary file replacing path once complete
+     * \param path - path to the snapshot file
+     * \return number of saved items
+     * \throw if the snapshot file cannot be written
+     */
+    size_t save(const std::string& path);
+
+    /**
+     * \brief Inserts items saved to a snapshot file by save
+     * \details The snapshot is memory-mapped and decoded into items before the cache is locked, and the items are
+     * linked in with a single lock acquisition per shard (see insert), restoring their recency order and dirty flags.
+     * If the snapshot holds more items than a shard can, the least recently used ones are evicted from the shard
+     * as more recent ones are linked in, executing the update hook on the dirty ones.
+     * The snapshot may have been saved by a cache with a different number of shards
+     * \param path - path to the snapshot file
+     * \return number of restored items, including the ones evicted in favour of more recent items of the snapshot
+     * \throw if the snapshot file cannot be read or is malformed (e.g. its header counts more items than it can hold)
+     */
+    size_t restore(const std::string& path);
+
+    /**
+     * \brief Changes the size (in objects) of the cache
+     * \details The size is spread evenly over shards. Growing takes effect immediately. When shrinking, the least
+     * recently used items of each shard are evicted in small batches, the shard lock being released between batches
+     * so lookups are only delayed by a batch at a time.
+     * Lookups racing with the shrink evict surplus items as well. The update hook is executed on evicted dirty
+     * items outside of the lock. The index is not rehashed: it keeps its buckets when shrinking, and grows
+     * geometrically as items are added when growing
+     * \param size - new size (in objects) of the cache
+     * \throw if size is 0 or smaller than the number of shards
+     */
+    void resize(size_t size);
+
+    /**
+     * \brief Returns an estimate of the memory (in bytes) used by the items in the cache
+     * \details Accounts for the recency queue and index nodes, the entries, the item objects and the known
+     * absences, but not for
+     * memory owned by keys or values (e.g. contents of strings) or by item locks
+     */
+    size_t memory_usage();
+
+    /**
+     * \brief Returns a snapshot of the usage counters of the cache
+     * \details Counters are kept per thread and aggregated on each call, so counting does not introduce
+     * contention between lookups. Counters incremented concurrently may or may not be included
+     */
+    Statistics stats();
+
+    /**
+     * \brief Returns the number of shards of the cache
+     */
+    size_t shard_count() const noexcept;
+
+    /**
+     * \brief Returns the index of the shard holding a given key
+     */
+    size_t shard_of(const KeyType& key) const;
+
+    /**
+     * \brief Returns the hash function of keys
+     */
+    const HashType& hash_function() const noexcept;
+
+    /**
+     * \brief Returns the value stored in items until they are first written or populated
+     */
+    const ValueType& default_value() const noexcept;
+
+    /**
+     * \brief Returns the NUMA node the index, queue and entries of a shard are allocated on
+     * \details Threads mostly accessing the keys of a shard may be bound to its node (see utility::numa_bind_thread)
+     * to avoid remote memory accesses. Always 0 unless the cache is NUMA-aware on a machine with multiple nodes
+     * \param shard - index of the shard
+     * \throw if shard is out of range
+     */
+    size_t shard_node(size_t shard) const;
     
   private:
-    void remove_latest();
-    ItemPtr add(const KeyType& key);
+    enum Counter
+    {
+      Hits,
+      Misses,
+      Evictions,
+      HookInvocations, ///< approximate, see Statistics
+      AbsentHits,
+      CounterCount
+    };
+
+    static constexpr size_t ScanStep = 64;
+    static constexpr size_t ResizeStep = 64;
+    static constexpr size_t LookupEvictionStep = 2;
+
+    // queue node (two links), entry with its shared_ptr control block (two counters),
+    // item object (virtual table pointer, dirty flag, lock policy pointer); the index accounts for itself
+    static constexpr size_t ItemFootprint =
+      2 * sizeof(void*) + sizeof(EntryPtr) +
+      2 * sizeof(long) + sizeof(Entry) +
+      3 * sizeof(void*) + sizeof(ValueType);
+
+    // index node (link and cached hash)
+    static constexpr size_t AbsentFootprint = 2 * sizeof(void*) + sizeof(std::pair<const KeyType, Clock::time_point>);
+
+    // entries removed by an operation, retired or destroyed (executing the update hook) after the lock is released
+    struct Evicted
+    {
+      explicit Evicted(Cache& cache) noexcept;
+      ~Evicted();
+
+      std::array<EntryPtr, LookupEvictionStep> entries;
+      Cache& cache;
+    };
+
+  private:
+    ItemPtr access(const KeyType& key, bool skipAbsent, const std::atomic<bool>*& unlinked);
+    const EntryPtr* locate(Shard& shard, const KeyType& key, size_t hash, bool create, bool skipAbsent, Evicted& evicted);
+    static bool expired(Clock::time_point expiry);
+    size_t shard_index(const KeyType& key, size_t hash) const noexcept;
+    Shard& shard_for(const KeyType& key, size_t hash) const noexcept;
+    EntryPtr make_entry(const KeyType& key, size_t hash, std::unique_ptr<Item<ValueType>>&& item) const;
+    EntryPtr remove_latest(Shard& shard);
+    EntryPtr remove_entry(Shard& shard, ItemIter iter, bool flush);
+    void mark_erased(Entry& entry, bool flush);
+    ItemIter add(Shard& shard, const KeyType& key, size_t hash);
+    ItemIter push(Shard& shard, EntryPtr&& entry);
+    void touch(Shard& shard, ItemIter iter);
+    void unlink(Shard& shard, ItemIter iter);
+    void set_size(Shard& shard, size_t size);
+    size_t link(std::vector<EntryPtr>& entries);
+    size_t link(Shard& shard, std::vector<EntryPtr>& entries);
+    template <typename Visit, typename Release>
+    void scan(Shard& shard, size_t step, Visit&& visit, Release&& release);
+    static size_t shard_size(size_t size, size_t shard, size_t shardCount) noexcept;
+    static ItemPtr to_item_ptr(const EntryPtr& entry);
+    template <typename Entries>
+    void retire(Entries& entries);
 
   private:
-    const size_t m_size;
-    const UpdateHook<KeyType, ValueType> m_updateHook;
-    const bool m_writeHeavy;
+    const HashType m_hash;
+    const std::shared_ptr<const UpdateHookType> m_updateHook;
+    const ItemOptions m_items;
     const ValueType m_defaultValue;
-    ItemQueue m_itemQueue;
-    ItemMap m_itemMap;
-    std::mutex m_mutex;
+    const double m_protectedRatio;
+    const std::unique_ptr<utility::EpochDomain> m_epochs; ///< null unless entries are reclaimed by epochs
+    std::vector<ShardPtr> m_shards;
+    std::mutex m_scanMutex; ///< serializes scans, which share the cursors of the shards
+    std::mutex m_resizeMutex;
+    utility::ShardedCounters<CounterCount> m_counters;
   };
 
+  /**
+   * \brief Creates a Cache with the update hook type deduced from updateHook
+   * \details Unlike UpdateHook, which type-erases the function object, the deduced hook is called directly
+   * \param size - size (in objects) of the cache
+   * \param updateHook - noexcept function object with void return type taking KeyType, ValueType and, optionally,
+   * UpdateReason as arguments
+   * \param items - implementation of items: a bool converts to the writeHeavy flag (WriteHeavyLockPolicy if true,
+   * ReadHeavyLockPolicy if false), and rcu selects RcuItem for values without lock-free atomic operations
+   * \param defaultValue - value stored in an item until it is first written
+   * \param sharding - number of shards and their placement on NUMA nodes
+   * \param eviction - eviction policy
+   */
+  template <
+    typename KeyType, 
+    typename ValueType, 
+    typename IndexPolicy = HashIndexPolicy, 
+    typename HashType = Hash<KeyType>, 
+    typename UpdateHookFwd
+  >
+  std::unique_ptr<Cache<KeyType, ValueType, std::decay_t<UpdateHookFwd>, IndexPolicy, HashType>> make_cache(
+    size_t size,
+    UpdateHookFwd&& updateHook,
+    const ItemOptions& items = ItemOptions(),
+    const ValueType& defaultValue = ValueType(),
+    const ShardingOptions& sharding = ShardingOptions(),
+    const EvictionOptions& eviction = EvictionOptions()
+  );
+
 }
 
 #include <cache/cache.hpp>
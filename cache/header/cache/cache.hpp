@@ -1,103 +1,1361 @@
 #pragma once
 
 #include <utility/exceptions.h>
+#include <utility/mapped_file.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include <stdio.h>
 
 namespace cache
 {
 
-  template <typename KeyType, typename ValueType>
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
   template <typename UpdateHookFwd>
-  Cache<KeyType, ValueType>::Cache(
+  Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::Cache(
     size_t size, 
     UpdateHookFwd&& updateHook, 
-    bool writeHeavy,
-    const ValueType& defaultValue
+    const ItemOptions& items,
+    const ValueType& defaultValue,
+    const ShardingOptions& sharding,
+    const EvictionOptions& eviction
   ) try
-    : m_size(size)
-    , m_updateHook(std::forward<UpdateHookFwd>(updateHook))
-    , m_writeHeavy(writeHeavy)
+    : m_hash()
+    , m_updateHook(std::make_shared<const UpdateHookType>(std::forward<UpdateHookFwd>(updateHook)))
+    , m_items(items)
     , m_defaultValue(defaultValue)
+    , m_protectedRatio(eviction.protectedRatio)
+    , m_epochs(eviction.epochReclamation ? std::make_unique<utility::EpochDomain>() : nullptr)
   {
-    THROW_IF(m_size == 0, "Attempt to create a Cache with size = 0!");
+    THROW_IF(!(m_protectedRatio >= 0. && m_protectedRatio < 1.), "Protected ratio = ", m_protectedRatio, " is out of [0, 1)!");
+    THROW_IF(size == 0, "Attempt to create a Cache with size = 0!");
+    THROW_IF(sharding.shardCount == 0, "Attempt to create a Cache with shard count = 0!");
+    THROW_IF(size < sharding.shardCount, "Attempt to create a Cache with fewer items than shards = ", sharding.shardCount);
+
+    auto nodeCount = sharding.numaAware ? utility::numa_node_count() : 1;
+
+    m_shards.reserve(sharding.shardCount);
+
+    for (size_t i = 0; i < sharding.shardCount; ++i)
+    {
+      auto shardSize = shard_size(size, i, sharding.shardCount);
+
+      if (nodeCount > 1)
+      {
+        // shards get an arena each, so the locks of shards on the same node do not share cache lines
+        auto node = i % nodeCount;
+        auto arena = std::make_shared<utility::NumaArena>(node);
 
-    m_itemMap.reserve(m_size);
+        m_shards.push_back(std::allocate_shared<Shard>(utility::NumaAllocator<Shard>(arena), shardSize, node, arena));
+      }
+      else
+      {
+        m_shards.push_back(std::make_shared<Shard>(shardSize, 0, nullptr));
+      }
+
+      set_size(*m_shards.back(), shardSize);
+    }
   }
   catch (...)
   {
-    RETHROW("Failed to create a ", (writeHeavy ? "write heavy" : "read heavy"), " Cache of size = ", size);
+    RETHROW("Failed to create a ", (items.writeHeavy ? "write heavy" : "read heavy"), (items.rcu ? " RCU" : ""), " Cache of size = ", size
+      , " with ", sharding.shardCount, (sharding.numaAware ? " NUMA-aware" : ""), " shard(s)");
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  typename Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::ItemPtr Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::operator[](const KeyType& key)
+  {
+    const std::atomic<bool>* unlinked;
+
+    return access(key, false, unlinked);
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  typename Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::ItemPtr Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::get(const KeyType& key)
+  {
+    const std::atomic<bool>* unlinked;
+
+    return access(key, true, unlinked);
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  typename Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::Handle Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::lookup(
+    const KeyType& key, 
+    bool skipAbsent
+  )
+  {
+    const std::atomic<bool>* unlinked;
+    auto item = access(key, skipAbsent, unlinked);
+
+    return Handle(std::move(item), unlinked);
   }
 
-  template <typename KeyType, typename ValueType>
-  typename Cache<KeyType, ValueType>::ItemPtr Cache<KeyType, ValueType>::operator[](const KeyType& key) try
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  bool Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::mark_absent(const KeyType& key, std::chrono::milliseconds ttl) try
   {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    // the dropped entry is retired or destroyed after the lock is released
+    Evicted dropped(*this);
+
+    auto hash = m_hash(key);
+    auto& shard = shard_for(key, hash);
+    std::lock_guard<Mutex> lock(shard.mutex);
 
-    auto mapIter = m_itemMap.find(key);
-    if (mapIter != m_itemMap.end())
+    auto mapIter = shard.map.find(key, hash);
+    if (mapIter)
     {
-      auto queueIter = mapIter->second;
-      THROW_IF(queueIter == m_itemQueue.end(), "Queue iterator for key = ", key, " is out of bound!");
-      THROW_IF(queueIter->key != key, "Keys are inconsistent between the queue and the map! Map key = ", key, ", queue key = ", queueIter->key);
+      auto queueIter = *mapIter;
+      if ((*queueIter)->item->dirty())
+      {
+        return false;
+      }
 
-      m_itemQueue.push_front(*queueIter);
-      mapIter->second = m_itemQueue.begin();
-      m_itemQueue.erase(queueIter);
+      auto& entry = dropped.entries.front();
+      entry = *queueIter;
+      entry->reason = UpdateReason::Evicted;
+      entry->unlinked.store(true, std::memory_order_release);
 
-      return m_itemQueue.front().item;
-    } 
+      shard.map.erase(key, hash);
+      unlink(shard, queueIter);
+    }
+
+    if (shard.absent.size() >= shard.size && shard.absent.count(key) == 0)
+    {
+      for (auto iter = shard.absent.begin(); iter != shard.absent.end();)
+      {
+        iter = expired(iter->second) ? shard.absent.erase(iter) : std::next(iter);
+      }
+
+      if (shard.absent.size() >= shard.size)
+      {
+        shard.absent.clear();
+      }
+    }
+
+    shard.absent[key] = ttl == std::chrono::milliseconds::zero() ? Clock::time_point::max() : Clock::now() + ttl;
+
+    return true;
+  }
+  catch (...)
+  {
+    RETHROW("Failed to mark key = ", key, " as absent!");
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  bool Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::absent(const KeyType& key)
+  {
+    auto& shard = shard_for(key, m_hash(key));
+    std::lock_guard<Mutex> lock(shard.mutex);
+
+    auto absentIter = shard.absent.find(key);
+    if (absentIter == shard.absent.end())
+    {
+      return false;
+    }
+
+    if (expired(absentIter->second))
+    {
+      shard.absent.erase(absentIter);
+      return false;
+    }
+
+    m_counters.add(AbsentHits);
+
+    return true;
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  template <typename Visitor>
+  bool Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::visit(const KeyType& key, Visitor&& visitor) try
+  {
+    // nothing is evicted without creating an item
+    Evicted evicted(*this);
+
+    auto hash = m_hash(key);
+    auto& shard = shard_for(key, hash);
+    std::lock_guard<Mutex> lock(shard.mutex);
+
+    auto entry = locate(shard, key, hash, false, false, evicted);
+    if (!entry)
+    {
+      return false;
+    }
+
+    visitor(*(*entry)->item);
+
+    return true;
+  }
+  catch (...)
+  {
+    RETHROW("Failed to visit key = ", key, " in the cache!");
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  template <typename Visitor>
+  decltype(auto) Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::visit_or_create(const KeyType& key, Visitor&& visitor) try
+  {
+    Evicted evicted(*this);
+
+    auto hash = m_hash(key);
+    auto& shard = shard_for(key, hash);
+    std::lock_guard<Mutex> lock(shard.mutex);
+
+    auto entry = locate(shard, key, hash, true, false, evicted);
+
+    return visitor(*(*entry)->item);
+  }
+  catch (...)
+  {
+    RETHROW("Failed to visit key = ", key, " in the cache!");
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  typename Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::Guard Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::pin() const
+  {
+    THROW_IF(!m_epochs, "Attempt to pin a Cache without epoch-based reclamation!");
+
+    return m_epochs->pin();
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  Item<ValueType>* Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::borrow(
+    const KeyType& key, 
+    const Guard& guard, 
+    bool skipAbsent
+  ) try
+  {
+    THROW_IF(!m_epochs || !guard.pins(*m_epochs), "The guard does not pin the epoch of the cache!");
+
+    Evicted evicted(*this);
+
+    auto hash = m_hash(key);
+    auto& shard = shard_for(key, hash);
+    std::lock_guard<Mutex> lock(shard.mutex);
+
+    auto entry = locate(shard, key, hash, true, skipAbsent, evicted);
+
+    return entry ? (*entry)->item.get() : nullptr;
+  }
+  catch (...)
+  {
+    RETHROW("Failed to borrow key = ", key, " from the cache!");
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::reclaim()
+  {
+    return m_epochs ? m_epochs->collect() : 0;
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  typename Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::ItemPtr Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::access(
+    const KeyType& key, 
+    bool skipAbsent,
+    const std::atomic<bool>*& unlinked
+  ) try
+  {
+    Evicted evicted(*this);
+
+    auto hash = m_hash(key);
+    auto& shard = shard_for(key, hash);
+    std::lock_guard<Mutex> lock(shard.mutex);
 
-    if (m_itemQueue.size() == m_size)
+    auto entry = locate(shard, key, hash, true, skipAbsent, evicted);
+    if (!entry)
     {
-      remove_latest();
+      unlinked = nullptr;
+      return nullptr;
     }
 
-    auto ptr = add(key);
+    unlinked = &(*entry)->unlinked;
 
-    return ptr;
+    return to_item_ptr(*entry);
   }
   catch (...)
   {
     RETHROW("Failed to access key = ", key, " in the cache!");
   }
 
-  template <typename KeyType, typename ValueType>
-  void Cache<KeyType, ValueType>::remove_latest() try
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  const typename Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::EntryPtr* Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::locate(
+    Shard& shard,
+    const KeyType& key, 
+    size_t hash,
+    bool create,
+    bool skipAbsent,
+    Evicted& evicted
+  )
   {
-    auto latest = m_itemQueue.back();
-    const auto& key = latest.key;
+    auto mapIter = shard.map.find(key, hash);
+    if (mapIter)
+    {
+      auto queueIter = *mapIter;
+      THROW_IF(queueIter == shard.queue.end(), "Queue iterator for key = ", key, " is out of bound!");
+      THROW_IF((*queueIter)->key != key, "Keys are inconsistent between the queue and the map! Map key = ", key, ", queue key = ", (*queueIter)->key);
 
-    auto mapIter = m_itemMap.find(key);
-    THROW_IF(mapIter == m_itemMap.end(), "Keys are inconsistent between the queue and the map! Latest key = "
-      , key, " in the queue is not found in the map!");
+      touch(shard, queueIter);
+
+      m_counters.add(Hits);
+
+      return &*queueIter;
+    } 
+
+    if (!create)
+    {
+      m_counters.add(Misses);
+      return nullptr;
+    }
+
+    if (!shard.absent.empty())
+    {
+      auto absentIter = shard.absent.find(key);
+      if (absentIter != shard.absent.end())
+      {
+        if (skipAbsent && !expired(absentIter->second))
+        {
+          m_counters.add(AbsentHits);
+
+          return nullptr;
+        }
+
+        shard.absent.erase(absentIter);
+      }
+    }
+
+    m_counters.add(Misses);
+
+    for (size_t i = 0; i < evicted.entries.size() && shard.queue.size() >= shard.size; ++i)
+    {
+      evicted.entries[i] = remove_latest(shard);
+    }
+
+    return &*add(shard, key, hash);
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  bool Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::erase(const KeyType& key, bool flush) try
+  {
+    // the erased entry is retired or destroyed after the lock is released
+    Evicted erased(*this);
+
+    auto hash = m_hash(key);
+    auto& shard = shard_for(key, hash);
+    std::lock_guard<Mutex> lock(shard.mutex);
+
+    if (!shard.absent.empty())
+    {
+      shard.absent.erase(key);
+    }
+
+    auto mapIter = shard.map.find(key, hash);
+    if (!mapIter)
+    {
+      return false;
+    }
 
-    m_itemQueue.pop_back();
-    m_itemMap.erase(mapIter);
+    erased.entries.front() = remove_entry(shard, *mapIter, flush);
+
+    return true;
   }
   catch (...)
   {
-    RETHROW("Failed to remove the latest element in the item queue of size = ", m_itemQueue.size());
+    RETHROW("Failed to erase key = ", key, " from the cache!");
   }
-  
-  template <typename KeyType, typename ValueType>
-  typename Cache<KeyType, ValueType>::ItemPtr Cache<KeyType, ValueType>::add(const KeyType& key)
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  template <typename Predicate>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::erase_if(Predicate&& predicate, bool flush) try
+  {
+    std::lock_guard<std::mutex> scanLock(m_scanMutex);
+
+    std::vector<EntryPtr> erased;
+    size_t count = 0;
+
+    for (const auto& shard : m_shards)
+    {
+      scan(
+        *shard, 
+        ScanStep, 
+        [this, &shard, &predicate, &erased, flush] (ItemIter iter)
+        {
+          const auto& entry = *iter;
+
+          if (predicate(entry->key, static_cast<const Item<ValueType>&>(*entry->item)))
+          {
+            erased.push_back(remove_entry(*shard, iter, flush));
+          }
+        },
+        [this, &erased, &count]
+        {
+          count += erased.size();
+
+          retire(erased);
+          erased.clear();
+        }
+      );
+    }
+
+    return count;
+  }
+  catch (...)
+  {
+    RETHROW("Failed to erase items matching a predicate from the cache!");
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::clear(bool flush) try
+  {
+    size_t count = 0;
+
+    for (const auto& shard : m_shards)
+    {
+      ItemQueue erased(shard->queue.get_allocator());
+
+      {
+        std::lock_guard<Mutex> lock(shard->mutex);
+
+        erased.splice(erased.end(), shard->queue);
+        shard->map.clear();
+        shard->absent.clear();
+        shard->probation = shard->queue.end();
+        shard->protectedCount = 0;
+        shard->cursor = shard->queue.end();
+        shard->unscanned = 0;
+
+        for (const auto& entry : erased)
+        {
+          entry->protectedSegment = false;
+          mark_erased(*entry, flush);
+        }
+      }
+
+      count += erased.size();
+
+      retire(erased);
+    }
+
+    return count;
+  }
+  catch (...)
+  {
+    RETHROW("Failed to clear the cache!");
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  template <typename InputIterator>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::insert(InputIterator first, InputIterator last) try
+  {
+    std::vector<EntryPtr> entries;
+    for (; first != last; ++first)
+    {
+      entries.push_back(make_entry(first->first, m_hash(first->first), make_item<ValueType>(first->second, m_items)));
+      entries.back()->item->mark_loaded();
+    }
+
+    return link(entries);
+  }
+  catch (...)
+  {
+    RETHROW("Failed to insert items into the cache!");
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  template <typename Loader>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::warm_up(
+    const std::vector<KeyType>& keys, 
+    Loader&& loader, 
+    size_t threadCount, 
+    size_t batchSize
+  ) try
+  {
+    THROW_IF(threadCount == 0, "Attempt to warm up with thread count = 0!");
+    THROW_IF(batchSize == 0, "Attempt to warm up with batch size = 0!");
+
+    size_t freeSize = 0;
+    for (const auto& shard : m_shards)
+    {
+      std::lock_guard<Mutex> lock(shard->mutex);
+
+      freeSize += shard->queue.size() < shard->size ? shard->size - shard->queue.size() : 0;
+    }
+
+    auto keyCount = std::min(keys.size(), freeSize);
+
+    auto partSize = (keyCount + threadCount - 1) / threadCount;
+
+    std::vector<std::future<size_t>> parts;
+
+    for (size_t begin = 0; begin < keyCount; begin += partSize)
+    {
+      auto end = std::min(begin + partSize, keyCount);
+
+      parts.push_back(std::async(std::launch::async, [this, &keys, &loader, begin, end, batchSize]
+      {
+        std::vector<KeyType> partKeys(keys.begin() + begin, keys.begin() + end);
+        auto values = loader(partKeys);
+
+        THROW_IF(values.size() > partKeys.size(), "Loader returned ", values.size(), " values for "
+          , partKeys.size(), " keys!");
+
+        std::vector<std::pair<KeyType, ValueType>> batch;
+        size_t inserted = 0;
+
+        for (size_t i = 0; i < values.size(); i += batchSize)
+        {
+          auto batchEnd = std::min(i + batchSize, values.size());
+
+          for (auto j = i; j < batchEnd; ++j)
+          {
+            batch.emplace_back(std::move(partKeys[j]), std::move(values[j]));
+          }
+
+          inserted += insert(batch.begin(), batch.end());
+          batch.clear();
+        }
+
+        return inserted;
+      }));
+    }
+
+    size_t inserted = 0;
+    std::exception_ptr exception;
+
+    for (auto& part : parts)
+    {
+      try
+      {
+        inserted += part.get();
+      }
+      catch (...)
+      {
+        exception = std::current_exception();
+      }
+    }
+
+    if (exception)
+    {
+      std::rethrow_exception(exception);
+    }
+
+    return inserted;
+  }
+  catch (...)
+  {
+    RETHROW("Failed to warm up the cache with ", keys.size(), " keys!");
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::flush()
+  {
+    return flush([this] (std::vector<std::pair<KeyType, ValueType>>& batch) noexcept
+    {
+      for (const auto& item : batch)
+      {
+        invoke_update_hook(*m_updateHook, item.first, item.second, UpdateReason::Flushed);
+      }
+    });
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  template <typename BatchHook>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::flush(BatchHook&& batchHook, size_t batchSize) try
+  {
+    THROW_IF(batchSize == 0, "Attempt to flush with batch size = 0!");
+
+    std::lock_guard<std::mutex> scanLock(m_scanMutex);
+
+    std::vector<EntryPtr> entries;
+    std::vector<std::pair<KeyType, ValueType>> batch;
+    size_t flushed = 0;
+
+    for (const auto& shard : m_shards)
+    {
+      // at most batchSize dirty entries are collected per lock hold, and flushed after the lock is released
+      scan(
+        *shard, 
+        batchSize, 
+        [&entries] (ItemIter iter)
+        {
+          if ((*iter)->item->dirty())
+          {
+            entries.push_back(*iter);
+          }
+        },
+        [this, &entries, &batch, &batchHook, &flushed]
+        {
+          for (const auto& entry : entries)
+          {
+            if (entry->item->clean())
+            {
+              batch.emplace_back(entry->key, entry->item->read());
+            }
+          }
+
+          entries.clear();
+
+          if (!batch.empty())
+          {
+            static_assert(noexcept(batchHook(batch)), "Batch hook must be a noexcept function!");
+
+            batchHook(batch);
+            flushed += batch.size();
+            m_counters.add(HookInvocations, batch.size());
+            batch.clear();
+          }
+        }
+      );
+    }
+
+    return flushed;
+  }
+  catch (...)
+  {
+    RETHROW("Failed to flush the cache!");
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::save(const std::string& path) try
   {
-    auto item = make_item<ValueType>(m_defaultValue, m_writeHeavy);
-    auto sharedItem = std::shared_ptr<Item<ValueType>>(
-      item.get(), 
-      [key, updateHook = m_updateHook] (Item<ValueType>* item)
+    std::vector<EntryPtr> entries;
+
+    for (const auto& shard : m_shards)
+    {
+      std::lock_guard<Mutex> lock(shard->mutex);
+
+      entries.insert(entries.end(), shard->queue.rbegin(), shard->queue.rend());
+    }
+
+    auto tempPath = path + ".tmp";
+
+    std::ofstream out(tempPath, std::ios_base::binary | std::ios_base::trunc);
+    THROW_IF(out.fail(), "Failed to open a temporary file = ", tempPath);
+
+    try
+    {
+      write_snapshot_header(out, entries.size());
+
+      for (const auto& entry : entries)
       {
-        updateHook(key, item->read());
-        free(item);
+        uint8_t flags = entry->item->dirty() ? SnapshotDirtyFlag : 0;
+
+        SnapshotCodec<uint8_t>::write(out, flags);
+        SnapshotCodec<KeyType>::write(out, entry->key);
+        SnapshotCodec<ValueType>::write(out, entry->item->read());
       }
+
+      out.close();
+      THROW_IF(out.fail(), "Failed to write the temporary file = ", tempPath);
+    }
+    catch (...)
+    {
+      out.close();
+      remove(tempPath.c_str());
+
+      throw;
+    }
+
+#ifdef _WIN32
+    // rename does not replace an existing file on Windows
+    remove(path.c_str());
+#endif
+
+    auto result = rename(tempPath.c_str(), path.c_str());
+    THROW_IF(result != 0, "Failed to rename temporary file '", tempPath, "' to '", path, "'");
+
+    return entries.size();
+  }
+  catch (...)
+  {
+    RETHROW("Failed to save the cache to snapshot = '", path, "'!");
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::restore(const std::string& path) try
+  {
+    utility::MappedFile file(path);
+
+    auto data = file.data();
+    auto end = data + file.size();
+
+    uint64_t count;
+    data = read_snapshot_header(data, end, count);
+
+    constexpr size_t MinEntrySize =
+      SnapshotCodec<uint8_t>::MinSize + SnapshotCodec<KeyType>::MinSize + SnapshotCodec<ValueType>::MinSize;
+    THROW_IF(
+      count > static_cast<uint64_t>(end - data) / MinEntrySize, 
+      "Snapshot of ", end - data, " bytes cannot hold count = ", count, " items!"
     );
-    item.release();
 
-    m_itemQueue.push_front({ key, std::move(sharedItem) });
-    auto front = m_itemQueue.front();
+    std::vector<EntryPtr> entries;
+    entries.reserve(static_cast<size_t>(count));
 
-    m_itemMap.emplace(key, m_itemQueue.begin());
+    for (uint64_t i = 0; i < count; ++i)
+    {
+      uint8_t flags;
+      KeyType key;
+      ValueType value;
 
-    return front.item;
+      data = SnapshotCodec<uint8_t>::read(data, end, flags);
+      data = SnapshotCodec<KeyType>::read(data, end, key);
+      data = SnapshotCodec<ValueType>::read(data, end, value);
+
+      if (flags & SnapshotDirtyFlag)
+      {
+        entries.push_back(make_entry(key, m_hash(key), make_item<ValueType>(m_defaultValue, m_items)));
+        entries.back()->item->update(std::move(value));
+      }
+      else
+      {
+        entries.push_back(make_entry(key, m_hash(key), make_item<ValueType>(std::move(value), m_items)));
+        entries.back()->item->mark_loaded();
+      }
+    }
+
+    THROW_IF(data != end, "Snapshot has ", end - data, " unexpected trailing bytes!");
+
+    return link(entries);
+  }
+  catch (...)
+  {
+    RETHROW("Failed to restore the cache from snapshot = '", path, "'!");
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  void Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::resize(size_t size) try
+  {
+    THROW_IF(size == 0, "Attempt to resize a Cache to size = 0!");
+    THROW_IF(size < m_shards.size(), "Attempt to resize a Cache to fewer items than shards = ", m_shards.size());
+
+    // concurrent resizes must not interleave the sizes of shards
+    std::lock_guard<std::mutex> resizeLock(m_resizeMutex);
+
+    for (size_t i = 0; i < m_shards.size(); ++i)
+    {
+      std::lock_guard<Mutex> lock(m_shards[i]->mutex);
+
+      set_size(*m_shards[i], shard_size(size, i, m_shards.size()));
+    }
+
+    std::vector<EntryPtr> evicted;
+    evicted.reserve(ResizeStep);
+
+    for (const auto& shard : m_shards)
+    {
+      bool shrunk = false;
+      while (!shrunk)
+      {
+        {
+          std::lock_guard<Mutex> lock(shard->mutex);
+
+          while (evicted.size() < ResizeStep && shard->queue.size() > shard->size)
+          {
+            evicted.push_back(remove_latest(*shard));
+          }
+
+          shrunk = shard->queue.size() <= shard->size;
+        }
+
+        retire(evicted);
+        evicted.clear();
+      }
+    }
+  }
+  catch (...)
+  {
+    RETHROW("Failed to resize the cache to size = ", size);
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::memory_usage()
+  {
+    size_t usage = 0;
+
+    for (const auto& shard : m_shards)
+    {
+      std::lock_guard<Mutex> lock(shard->mutex);
+
+      usage += shard->queue.size() * ItemFootprint + shard->map.memory();
+      usage += shard->absent.size() * AbsentFootprint + shard->absent.bucket_count() * sizeof(void*);
+    }
+
+    return usage;
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  Statistics Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::stats()
+  {
+    Statistics result;
+
+    result.hits = m_counters.load(Hits);
+    result.misses = m_counters.load(Misses);
+    result.evictions = m_counters.load(Evictions);
+    result.hookInvocations = m_counters.load(HookInvocations);
+    result.absentHits = m_counters.load(AbsentHits);
+
+    result.capacity = 0;
+    result.queueSize = 0;
+    result.mapSize = 0;
+    result.absentSize = 0;
+    result.retiredSize = m_epochs ? m_epochs->retired() : 0;
+
+    for (const auto& shard : m_shards)
+    {
+      std::lock_guard<Mutex> lock(shard->mutex);
+
+      result.capacity += shard->size;
+      result.queueSize += shard->queue.size();
+      result.mapSize += shard->map.size();
+      result.absentSize += shard->absent.size();
+    }
+
+    return result;
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::shard_count() const noexcept
+  {
+    return m_shards.size();
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::shard_of(const KeyType& key) const
+  {
+    return shard_index(key, m_hash(key));
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  const HashType& Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::hash_function() const noexcept
+  {
+    return m_hash;
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  const ValueType& Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::default_value() const noexcept
+  {
+    return m_defaultValue;
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::shard_node(size_t shard) const try
+  {
+    THROW_IF(shard >= m_shards.size(), "Shard index is out of range! Shard count = ", m_shards.size());
+
+    return m_shards[shard]->node;
+  }
+  catch (...)
+  {
+    RETHROW("Failed to get the NUMA node of shard = ", shard);
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::shard_index(const KeyType& key, size_t hash) const noexcept
+  {
+    if (m_shards.size() == 1)
+    {
+      return 0;
+    }
+
+    // the upper bits of a multiplicative mix spread keys even if a custom hash function is poorly distributed
+    auto mixed = static_cast<uint64_t>(IndexPolicy::shard_hash(key, hash)) * 0x9E3779B97F4A7C15ull;
+
+    return static_cast<size_t>((mixed >> 32) % m_shards.size());
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  typename Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::Shard& Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::shard_for(const KeyType& key, size_t hash) const noexcept
+  {
+    return *m_shards[shard_index(key, hash)];
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  typename Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::EntryPtr Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::make_entry(
+    const KeyType& key, 
+    size_t hash,
+    std::unique_ptr<Item<ValueType>>&& item
+  ) const
+  {
+    const auto& arena = shard_for(key, hash).arena;
+
+    if (arena)
+    {
+      return std::allocate_shared<Entry>(utility::NumaAllocator<Entry>(arena), key, hash, std::move(item), m_updateHook);
+    }
+
+    return std::make_shared<Entry>(key, hash, std::move(item), m_updateHook);
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  typename Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::EntryPtr Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::remove_latest(Shard& shard) try
+  {
+    auto latest = shard.queue.back();
+    const auto& key = latest->key;
+
+    THROW_IF(!shard.map.erase(key, latest->hash), "Keys are inconsistent between the queue and the map! Latest key = "
+      , key, " in the queue is not found in the map!");
+
+    latest->reason = UpdateReason::Evicted;
+    latest->unlinked.store(true, std::memory_order_release);
+
+    m_counters.add(Evictions);
+    if (latest->item->dirty())
+    {
+      m_counters.add(HookInvocations);
+    }
+
+    unlink(shard, std::prev(shard.queue.end()));
+
+    return latest;
+  }
+  catch (...)
+  {
+    RETHROW("Failed to remove the latest element in the item queue of size = ", shard.queue.size());
+  }
+  
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  typename Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::EntryPtr Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::remove_entry(Shard& shard, ItemIter iter, bool flush)
+  {
+    auto entry = *iter;
+
+    shard.map.erase(entry->key, entry->hash);
+    mark_erased(*entry, flush);
+    unlink(shard, iter);
+
+    return entry;
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  void Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::mark_erased(Entry& entry, bool flush)
+  {
+    entry.reason = UpdateReason::Erased;
+    entry.unlinked.store(true, std::memory_order_release);
+
+    if (!flush)
+    {
+      entry.item->clean();
+    }
+    else if (entry.item->dirty())
+    {
+      m_counters.add(HookInvocations);
+    }
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  typename Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::ItemIter Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::add(Shard& shard, const KeyType& key, size_t hash)
+  {
+    auto entry = make_entry(key, hash, make_item<ValueType>(m_defaultValue, m_items));
+
+    auto iter = push(shard, std::move(entry));
+
+    try
+    {
+      shard.map.emplace(key, hash, iter);
+    }
+    catch (...)
+    {
+      // the index rejected the key, e.g. one out of the range of a dense index, so the queue must not keep it
+      unlink(shard, iter);
+      throw;
+    }
+
+    return iter;
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  typename Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::ItemIter Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::push(
+    Shard& shard, 
+    EntryPtr&& entry
+  )
+  {
+    // new items enter the front of the probationary segment, i.e. the front of the queue in a plain cache;
+    // they are skipped by a running scan
+    entry->scanned = shard.scanId;
+    shard.probation = shard.queue.insert(shard.probation, std::move(entry));
+
+    return shard.probation;
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  void Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::touch(Shard& shard, ItemIter iter)
+  {
+    auto& entry = *iter;
+
+    if (iter == shard.cursor)
+    {
+      ++shard.cursor;
+    }
+
+    if (shard.protectedSize == 0)
+    {
+      // in a plain cache, all items are probationary
+      shard.queue.splice(shard.queue.begin(), shard.queue, iter);
+      shard.probation = shard.queue.begin();
+      return;
+    }
+
+    if (entry->protectedSegment)
+    {
+      shard.queue.splice(shard.queue.begin(), shard.queue, iter);
+      return;
+    }
+
+    if (iter == shard.probation)
+    {
+      ++shard.probation;
+    }
+
+    shard.queue.splice(shard.queue.begin(), shard.queue, iter);
+    entry->protectedSegment = true;
+    ++shard.protectedCount;
+
+    if (shard.protectedCount > shard.protectedSize)
+    {
+      // the least recently used protected item becomes the most recently used probationary one
+      --shard.probation;
+      (*shard.probation)->protectedSegment = false;
+      --shard.protectedCount;
+    }
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  void Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::unlink(Shard& shard, ItemIter iter)
+  {
+    if (iter == shard.probation)
+    {
+      ++shard.probation;
+    }
+
+    if (iter == shard.cursor)
+    {
+      ++shard.cursor;
+    }
+
+    if (shard.unscanned != 0 && (*iter)->scanned != shard.scanId)
+    {
+      --shard.unscanned;
+    }
+
+    if ((*iter)->protectedSegment)
+    {
+      --shard.protectedCount;
+    }
+
+    shard.queue.erase(iter);
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  void Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::set_size(Shard& shard, size_t size)
+  {
+    shard.size = size;
+    shard.protectedSize = static_cast<size_t>(static_cast<double>(size) * m_protectedRatio);
+
+    while (shard.protectedCount > shard.protectedSize)
+    {
+      --shard.probation;
+      (*shard.probation)->protectedSegment = false;
+      --shard.protectedCount;
+    }
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::link(std::vector<EntryPtr>& entries)
+  {
+    if (m_shards.size() == 1)
+    {
+      return link(*m_shards.front(), entries);
+    }
+
+    std::vector<std::vector<EntryPtr>> parts(m_shards.size());
+
+    for (auto& entry : entries)
+    {
+      parts[shard_index(entry->key, entry->hash)].push_back(std::move(entry));
+    }
+
+    size_t linked = 0;
+
+    for (size_t i = 0; i < parts.size(); ++i)
+    {
+      if (!parts[i].empty())
+      {
+        linked += link(*m_shards[i], parts[i]);
+      }
+    }
+
+    return linked;
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::link(Shard& shard, std::vector<EntryPtr>& entries)
+  {
+    size_t linked = 0;
+
+    std::unique_lock<Mutex> lock(shard.mutex);
+
+    try
+    {
+      for (auto& entry : entries)
+      {
+        if (shard.map.find(entry->key, entry->hash))
+        {
+          // the item in the cache is more recent, so the value of the dropped one must not reach the update hook
+          entry->item->clean();
+          continue;
+        }
+
+        auto iter = push(shard, std::move(entry));
+
+        try
+        {
+          shard.map.emplace((*iter)->key, (*iter)->hash, iter);
+        }
+        catch (...)
+        {
+          // nothing is evicted yet, so the rejected entry is the only one to take out of the queue
+          entry = *iter;
+          unlink(shard, iter);
+          throw;
+        }
+
+        if (!shard.absent.empty())
+        {
+          shard.absent.erase((*iter)->key);
+        }
+
+        // evicted entries are destroyed with the caller's vector, after the lock is released
+        if (shard.queue.size() > shard.size)
+        {
+          entry = remove_latest(shard);
+        }
+
+        ++linked;
+      }
+    }
+    catch (...)
+    {
+      lock.unlock();
+      retire(entries);
+      throw;
+    }
+
+    lock.unlock();
+
+    retire(entries);
+
+    return linked;
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  template <typename Visit, typename Release>
+  void Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::scan(
+    Shard& shard, 
+    size_t step, 
+    Visit&& visit, 
+    Release&& release
+  )
+  {
+    // items are walked from the back of the queue, while touched and new items enter it in front of the cursor;
+    // items visited already are recognized by their scan id, so they are neither skipped nor visited again
+    {
+      std::lock_guard<Mutex> lock(shard.mutex);
+
+      ++shard.scanId;
+      shard.cursor = shard.queue.end();
+      shard.unscanned = shard.queue.size();
+    }
+
+    for (bool done = false; !done; )
+    {
+      try
+      {
+        std::lock_guard<Mutex> lock(shard.mutex);
+
+        for (size_t i = 0; i < step && shard.unscanned != 0 && shard.cursor != shard.queue.begin(); ++i)
+        {
+          // the cursor rests on the visited item, and moves past it if the item is touched or removed
+          auto iter = --shard.cursor;
+
+          if ((*iter)->scanned == shard.scanId)
+          {
+            continue;
+          }
+
+          (*iter)->scanned = shard.scanId;
+          --shard.unscanned;
+
+          visit(iter);
+        }
+
+        done = shard.unscanned == 0 || shard.cursor == shard.queue.begin();
+
+        if (done)
+        {
+          shard.cursor = shard.queue.end();
+          shard.unscanned = 0;
+        }
+      }
+      catch (...)
+      {
+        {
+          std::lock_guard<Mutex> lock(shard.mutex);
+
+          shard.cursor = shard.queue.end();
+          shard.unscanned = 0;
+        }
+
+        release();
+        throw;
+      }
+
+      release();
+    }
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  bool Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::expired(Clock::time_point expiry)
+  {
+    return expiry != Clock::time_point::max() && expiry <= Clock::now();
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  size_t Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::shard_size(size_t size, size_t shard, size_t shardCount) noexcept
+  {
+    return size / shardCount + (shard < size % shardCount ? 1 : 0);
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  typename Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::ItemPtr Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::to_item_ptr(const EntryPtr& entry)
+  {
+    return ItemPtr(entry, entry->item.get());
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  template <typename Entries>
+  void Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::retire(Entries& entries)
+  {
+    if (!m_epochs)
+    {
+      return;
+    }
+
+    for (auto& entry : entries)
+    {
+      // the hook is executed right away, so that the evicted value is not loaded again from storage meanwhile;
+      // the entry executes it again on release if a borrower writes to it until then
+      if (entry && entry->item->clean())
+      {
+        invoke_update_hook(*m_updateHook, entry->key, entry->item->read(), entry->reason);
+      }
+
+      m_epochs->retire(std::move(entry));
+    }
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::Shard::Shard(
+    size_t size, 
+    size_t node, 
+    const std::shared_ptr<utility::NumaArena>& arena
+  )
+    : size(size)
+    , node(node)
+    , arena(arena)
+    , queue(utility::NumaAllocator<EntryPtr>(arena))
+    , probation(queue.end())
+    , protectedSize(0)
+    , protectedCount(0)
+    , map(size, queue.end(), utility::NumaAllocator<ItemIter>(arena))
+    , absent(utility::NumaAllocator<std::pair<const KeyType, Clock::time_point>>(arena))
+    , cursor(queue.end())
+    , scanId(0)
+    , unscanned(0)
+    , mutex(utility::profiled_lock("cache"))
+  {
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::Entry::Entry(
+    const KeyType& key, 
+    size_t hash,
+    std::unique_ptr<Item<ValueType>>&& item, 
+    const std::shared_ptr<const UpdateHookType>& updateHook
+  )
+    : UpdateHookRef<UpdateHookType>(updateHook)
+    , key(key)
+    , hash(hash)
+    , item(std::move(item))
+    , reason(UpdateReason::Destroyed)
+    , unlinked(false)
+    , protectedSegment(false)
+    , scanned(0)
+  {
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::Entry::~Entry()
+  {
+    if (item->dirty())
+    {
+      invoke_update_hook(this->update_hook(), key, item->read(), reason);
+    }
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::Evicted::Evicted(Cache& cache) noexcept
+    : cache(cache)
+  {
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::Evicted::~Evicted()
+  {
+    cache.retire(entries);
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::Handle::Handle() noexcept
+    : m_unlinked(nullptr)
+  {
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::Handle::Handle(ItemPtr&& item, const std::atomic<bool>* unlinked) noexcept
+    : m_item(std::move(item))
+    , m_unlinked(unlinked)
+  {
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  const typename Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::ItemPtr& Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::Handle::item() const noexcept
+  {
+    return m_item;
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  bool Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::Handle::linked() const noexcept
+  {
+    // the flag lives in the entry kept alive by m_item
+    return m_unlinked && !m_unlinked->load(std::memory_order_acquire);
+  }
+
+  template <typename KeyType, typename ValueType, typename IndexPolicy, typename HashType, typename UpdateHookFwd>
+  std::unique_ptr<Cache<KeyType, ValueType, std::decay_t<UpdateHookFwd>, IndexPolicy, HashType>> make_cache(
+    size_t size,
+    UpdateHookFwd&& updateHook,
+    const ItemOptions& items,
+    const ValueType& defaultValue,
+    const ShardingOptions& sharding,
+    const EvictionOptions& eviction
+  )
+  {
+    return std::make_unique<Cache<KeyType, ValueType, std::decay_t<UpdateHookFwd>, IndexPolicy, HashType>>(
+      size, 
+      std::forward<UpdateHookFwd>(updateHook), 
+      items, 
+      defaultValue,
+      sharding,
+      eviction
+    );
   }
 
 }
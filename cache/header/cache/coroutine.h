@@ -0,0 +1,94 @@
+#pragma once
+
+#if !defined(__cpp_impl_coroutine)
+#error "cache/coroutine.h requires C++20 coroutines, configure with -DCACHE_COROUTINES=ON"
+#endif
+
+#include <cache/cache.h>
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+
+namespace cache
+{
+
+  /**
+   * \class GetAwaiter
+   * \brief Awaitable lookup of a key in a Cache, loading the value of the key on an executor on a miss
+   * \details The item is looked up when the awaiter is awaited (see Cache::get). If it holds a loaded value (see
+   * Item::loaded), or the key is known to be absent, the awaiting coroutine continues without suspending.
+   * Otherwise, it is suspended while the executor runs the loader, whose result populates the item (see
+   * Item::populate), and resumed by the executor thread once the load completes. Concurrent loads of a key are
+   * not merged, the first one to complete filling the item
+   * \tparam CacheType - type of the cache
+   * \tparam KeyType - type of keys of the cache
+   * \tparam Loader - function object taking const KeyType& as argument and returning the value of the key,
+   * run on the executor
+   * \tparam Executor - function object taking std::function<void()> as argument and running it asynchronously
+   * (e.g. posting it to the queue of an I/O thread pool). If it throws, the load is skipped unless it has already
+   * started, in which case the exception is dropped
+   */
+  template <typename CacheType, typename KeyType, typename Loader, typename Executor>
+  class GetAwaiter
+  {
+  public:
+    using ItemPtr = typename CacheType::ItemPtr;
+
+  public:
+    GetAwaiter(CacheType& cache, const KeyType& key, Loader loader, Executor executor);
+
+    /**
+     * \brief Looks the key up, returning true on a hit or a known absence
+     */
+    bool await_ready();
+
+    /**
+     * \brief Passes the load of the value to the executor, which resumes the coroutine once it completes
+     * \return false if the executor has thrown before running the load, so the coroutine is not suspended
+     */
+    bool await_suspend(std::coroutine_handle<> coroutine);
+
+    /**
+     * \brief Returns the item for the key, or null if the key is known to be absent
+     * \throw if the loader or the executor has thrown
+     */
+    ItemPtr await_resume();
+
+  private:
+    CacheType& m_cache;
+    const KeyType m_key;
+    Loader m_loader;
+    Executor m_executor;
+    ItemPtr m_item;
+    std::exception_ptr m_exception;
+  };
+
+  /**
+   * \brief Returns an awaitable lookup of a key in a cache, suspending the awaiting coroutine while the value is loaded
+   * on a miss (see GetAwaiter)
+   * \details The cache, as well as the executor and the loader if they are references, must outlive the await
+   * \param cache - cache to look the key up in
+   * \param key - key to look up
+   * \param loader - function object taking const KeyType& as argument and returning the value of the key
+   * \param executor - function object taking std::function<void()> as argument and running it asynchronously
+   */
+  template <
+    typename KeyType, 
+    typename ValueType, 
+    typename UpdateHookType, 
+    typename IndexPolicy, 
+    typename HashType, 
+    typename Loader, 
+    typename Executor
+  >
+  GetAwaiter<Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>, KeyType, std::decay_t<Loader>, std::decay_t<Executor>> co_get(
+    Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>& cache, 
+    const KeyType& key, 
+    Loader&& loader, 
+    Executor&& executor
+  );
+
+}
+
+#include <cache/coroutine.hpp>
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace cache
+{
+
+  template <typename CacheType, typename KeyType, typename Loader, typename Executor>
+  GetAwaiter<CacheType, KeyType, Loader, Executor>::GetAwaiter(CacheType& cache, const KeyType& key, Loader loader, Executor executor)
+    : m_cache(cache)
+    , m_key(key)
+    , m_loader(std::move(loader))
+    , m_executor(std::move(executor))
+  {
+  }
+
+  template <typename CacheType, typename KeyType, typename Loader, typename Executor>
+  bool GetAwaiter<CacheType, KeyType, Loader, Executor>::await_ready()
+  {
+    m_item = m_cache.get(m_key);
+
+    return !m_item || m_item->loaded();
+  }
+
+  template <typename CacheType, typename KeyType, typename Loader, typename Executor>
+  bool GetAwaiter<CacheType, KeyType, Loader, Executor>::await_suspend(std::coroutine_handle<> coroutine)
+  {
+    // the coroutine is resumed either by the load or, if the executor throws before running it, right away;
+    // the flag outlives the awaiter, so the side claiming it second leaves the coroutine and the awaiter alone
+    auto claimed = std::make_shared<std::atomic<bool>>(false);
+
+    // the awaiter lives in the frame of the suspended coroutine until it is resumed
+    auto load = [this, coroutine, claimed] () noexcept
+    {
+      if (claimed->exchange(true))
+      {
+        return;
+      }
+
+      try
+      {
+        m_item->populate(m_cache.default_value(), m_loader(m_key));
+      }
+      catch (...)
+      {
+        m_exception = std::current_exception();
+      }
+
+      coroutine.resume();
+    };
+
+    try
+    {
+      m_executor(std::function<void()>(load));
+    }
+    catch (...)
+    {
+      if (claimed->exchange(true))
+      {
+        // the load has run or is running, so it resumes the coroutine, which may already be destroyed
+        return true;
+      }
+
+      // the load is not run, so the coroutine continues right away
+      m_exception = std::current_exception();
+
+      return false;
+    }
+
+    // the coroutine may already have been resumed and the awaiter destroyed
+    return true;
+  }
+
+  template <typename CacheType, typename KeyType, typename Loader, typename Executor>
+  typename GetAwaiter<CacheType, KeyType, Loader, Executor>::ItemPtr GetAwaiter<CacheType, KeyType, Loader, Executor>::await_resume()
+  {
+    if (m_exception)
+    {
+      std::rethrow_exception(m_exception);
+    }
+
+    return std::move(m_item);
+  }
+
+  template <
+    typename KeyType, 
+    typename ValueType, 
+    typename UpdateHookType, 
+    typename IndexPolicy, 
+    typename HashType, 
+    typename Loader, 
+    typename Executor
+  >
+  GetAwaiter<Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>, KeyType, std::decay_t<Loader>, std::decay_t<Executor>> co_get(
+    Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>& cache, 
+    const KeyType& key, 
+    Loader&& loader, 
+    Executor&& executor
+  )
+  {
+    return { cache, key, std::forward<Loader>(loader), std::forward<Executor>(executor) };
+  }
+
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace cache
+{
+
+  /**
+   * \brief Number of low bits of a key selecting its slot within a page of a DenseIndex
+   */
+  constexpr size_t DensePageBits = 10;
+
+  /**
+   * \class DenseIndex
+   * \brief Index of cache entries by integral key backed by a two-level radix table
+   * \details A key is split into a page number and an offset: the page is found in a directory, and the value is
+   * stored at the offset within the page, so a lookup takes two dependent memory accesses and no hashing.
+   * Pages are allocated on first use and freed once empty, so memory is proportional to the range of keys in use
+   * rather than to the largest key. Keys are expected to be dense non-negative integers (e.g. line numbers);
+   * keys beyond MaxKey are rejected
+   * \tparam Key - integral type of keys
+   * \tparam Value - type of indexed values, equality comparable
+   * \tparam Allocator - allocator of pages
+   */
+  template <typename Key, typename Value, typename Allocator>
+  class DenseIndex
+  {
+    static_assert(std::is_integral<Key>::value, "Dense index requires integral keys!");
+
+  public:
+    static constexpr size_t PageBits = DensePageBits;
+    static constexpr size_t PageSize = size_t(1) << PageBits;
+    static constexpr size_t MaxKey = (size_t(1) << 31) - 1;
+
+  public:
+    /**
+     * \brief Constructor
+     * \param capacity - expected number of keys
+     * \param empty - value stored in slots of absent keys, never passed to emplace
+     * \param allocator - allocator of pages
+     */
+    DenseIndex(size_t capacity, const Value& empty, const Allocator& allocator);
+
+    DenseIndex(const DenseIndex&) = delete;
+    DenseIndex& operator=(const DenseIndex&) = delete;
+
+    ~DenseIndex();
+
+    /**
+     * \brief Returns a pointer to the value of a key, or null if the key is absent
+     * \param hash - hash of the key, unused
+     */
+    Value* find(const Key& key, size_t hash) noexcept;
+
+    /**
+     * \brief Adds an absent key
+     * \param hash - hash of the key, unused
+     * \throw if the key is negative or exceeds MaxKey
+     */
+    void emplace(const Key& key, size_t hash, const Value& value);
+
+    /**
+     * \brief Removes a key
+     * \param hash - hash of the key, unused
+     * \return false if the key was absent
+     */
+    bool erase(const Key& key, size_t hash) noexcept;
+
+    /**
+     * \brief Removes all keys, freeing all pages
+     */
+    void clear() noexcept;
+
+    /**
+     * \brief Returns the number of keys
+     */
+    size_t size() const noexcept;
+
+    /**
+     * \brief Returns an estimate of the memory (in bytes) used by the index
+     */
+    size_t memory() const noexcept;
+
+  private:
+    struct Page
+    {
+      Value slots[PageSize];
+      size_t count;
+    };
+
+    using PageAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Page>;
+    using Directory = std::vector<Page*, typename std::allocator_traits<Allocator>::template rebind_alloc<Page*>>;
+
+  private:
+    static size_t to_index(const Key& key) noexcept;
+
+  private:
+    const Value m_empty;
+    PageAllocator m_allocator;
+    Directory m_pages;
+    size_t m_size;
+    size_t m_pageCount;
+  };
+
+  /**
+   * \class DenseIndexPolicy
+   * \brief Selects DenseIndex as the index of a Cache
+   */
+  struct DenseIndexPolicy
+  {
+    template <typename Key, typename Value, typename Allocator>
+    using Index = DenseIndex<Key, Value, Allocator>;
+
+    /**
+     * \brief Returns the value selecting the shard of a key: the number of its page
+     * \details Keys of a page share a shard, so each page is only allocated by a single shard and filled by
+     * consecutive keys, instead of every shard allocating it for a fraction of its keys
+     */
+    template <typename Key>
+    static size_t shard_hash(const Key& key, size_t hash) noexcept;
+  };
+
+}
+
+#include <cache/dense_index.hpp>
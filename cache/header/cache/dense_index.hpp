@@ -0,0 +1,160 @@
+#pragma once
+
+#include <utility/exceptions.h>
+
+#include <new>
+
+namespace cache
+{
+
+  template <typename Key, typename Value, typename Allocator>
+  constexpr size_t DenseIndex<Key, Value, Allocator>::PageBits;
+
+  template <typename Key, typename Value, typename Allocator>
+  constexpr size_t DenseIndex<Key, Value, Allocator>::PageSize;
+
+  template <typename Key, typename Value, typename Allocator>
+  constexpr size_t DenseIndex<Key, Value, Allocator>::MaxKey;
+
+  template <typename Key, typename Value, typename Allocator>
+  DenseIndex<Key, Value, Allocator>::DenseIndex(size_t capacity, const Value& empty, const Allocator& allocator)
+    : m_empty(empty)
+    , m_allocator(allocator)
+    , m_pages(typename Directory::allocator_type(allocator))
+    , m_size(0)
+    , m_pageCount(0)
+  {
+    m_pages.reserve(capacity / PageSize + 1);
+  }
+
+  template <typename Key, typename Value, typename Allocator>
+  DenseIndex<Key, Value, Allocator>::~DenseIndex()
+  {
+    clear();
+  }
+
+  template <typename Key, typename Value, typename Allocator>
+  Value* DenseIndex<Key, Value, Allocator>::find(const Key& key, size_t) noexcept
+  {
+    auto index = to_index(key);
+    auto pageIndex = index >> PageBits;
+
+    if (pageIndex >= m_pages.size() || !m_pages[pageIndex])
+    {
+      return nullptr;
+    }
+
+    auto& slot = m_pages[pageIndex]->slots[index & (PageSize - 1)];
+
+    return slot == m_empty ? nullptr : &slot;
+  }
+
+  template <typename Key, typename Value, typename Allocator>
+  void DenseIndex<Key, Value, Allocator>::emplace(const Key& key, size_t, const Value& value) try
+  {
+    auto index = to_index(key);
+    THROW_IF(index > MaxKey, "Key is out of the range of the dense index! Max key = ", MaxKey);
+
+    auto pageIndex = index >> PageBits;
+
+    if (pageIndex >= m_pages.size())
+    {
+      m_pages.resize(pageIndex + 1, nullptr);
+    }
+
+    auto& page = m_pages[pageIndex];
+
+    if (!page)
+    {
+      auto newPage = m_allocator.allocate(1);
+      new (newPage) Page;
+
+      for (auto& slot : newPage->slots)
+      {
+        slot = m_empty;
+      }
+
+      newPage->count = 0;
+
+      page = newPage;
+      ++m_pageCount;
+    }
+
+    page->slots[index & (PageSize - 1)] = value;
+    ++page->count;
+    ++m_size;
+  }
+  catch (...)
+  {
+    RETHROW("Failed to add key = ", key, " to the dense index!");
+  }
+
+  template <typename Key, typename Value, typename Allocator>
+  bool DenseIndex<Key, Value, Allocator>::erase(const Key& key, size_t hash) noexcept
+  {
+    auto slot = find(key, hash);
+    if (!slot)
+    {
+      return false;
+    }
+
+    *slot = m_empty;
+    --m_size;
+
+    auto& page = m_pages[to_index(key) >> PageBits];
+    if (--page->count == 0)
+    {
+      page->~Page();
+      m_allocator.deallocate(page, 1);
+
+      page = nullptr;
+      --m_pageCount;
+    }
+
+    return true;
+  }
+
+  template <typename Key, typename Value, typename Allocator>
+  void DenseIndex<Key, Value, Allocator>::clear() noexcept
+  {
+    for (auto& page : m_pages)
+    {
+      if (page)
+      {
+        page->~Page();
+        m_allocator.deallocate(page, 1);
+
+        page = nullptr;
+      }
+    }
+
+    m_size = 0;
+    m_pageCount = 0;
+  }
+
+  template <typename Key, typename Value, typename Allocator>
+  size_t DenseIndex<Key, Value, Allocator>::size() const noexcept
+  {
+    return m_size;
+  }
+
+  template <typename Key, typename Value, typename Allocator>
+  size_t DenseIndex<Key, Value, Allocator>::memory() const noexcept
+  {
+    return m_pageCount * sizeof(Page) + m_pages.capacity() * sizeof(Page*);
+  }
+
+  template <typename Key, typename Value, typename Allocator>
+  size_t DenseIndex<Key, Value, Allocator>::to_index(const Key& key) noexcept
+  {
+    // negative keys become too large to be stored
+    return static_cast<size_t>(static_cast<typename std::make_unsigned<Key>::type>(key));
+  }
+
+  template <typename Key>
+  size_t DenseIndexPolicy::shard_hash(const Key& key, size_t) noexcept
+  {
+    return static_cast<size_t>(static_cast<typename std::make_unsigned<Key>::type>(key)) >> DensePageBits;
+  }
+
+}
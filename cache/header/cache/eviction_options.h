@@ -0,0 +1,25 @@
+#pragma once
+
+namespace cache
+{
+
+  /**
+   * \class EvictionOptions
+   * \brief Options of the eviction policy of a Cache
+   * \details With a positive protectedRatio, the cache is a segmented least-recently used cache: new items enter
+   * a probationary segment and are only promoted to a protected segment when hit again. Items are evicted from the
+   * probationary segment first, and protected items exceeding the share of the protected segment are demoted back to
+   * the probationary one, so a scan of keys used once only displaces other probationary items.
+   * With epochReclamation, entries leaving the cache are retired to an epoch domain instead of being released
+   * right away, so items can be borrowed by readers without shared pointers (see Cache::borrow)
+   */
+  struct EvictionOptions
+  {
+    double protectedRatio = 0.; ///< share of the size of each shard reserved for protected items, in [0, 1);
+                                ///< 0 stands for a plain least-recently used cache
+    bool epochReclamation = false; ///< if true, evicted items are released once no reader pinned before their
+                                   ///< eviction is pinned anymore, the update hook being executed again on those
+                                   ///< written to meanwhile
+  };
+
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cache
+{
+
+  /**
+   * \class BasicFixedString
+   * \brief Sequence of up to Capacity characters stored inline
+   * \details Trivially copyable, so items of short values need no allocation besides the item itself and may use
+   * lock-free or sequence-locked access (see make_item). Unused characters are kept zeroed, so equal strings are
+   * equal byte by byte
+   * \tparam Capacity - maximum number of characters, below 256
+   * \tparam CharType - type of characters, of a single byte (e.g. char or unsigned char)
+   */
+  template <size_t Capacity, typename CharType = char>
+  class BasicFixedString
+  {
+    static_assert(Capacity > 0 && Capacity < 256, "Capacity of a BasicFixedString must be in [1, 255]!");
+    static_assert(sizeof(CharType) == 1, "Characters of a BasicFixedString must be single bytes!");
+
+  public:
+    /**
+     * \brief Constructs an empty string
+     */
+    BasicFixedString() noexcept;
+
+    /**
+     * \brief Copies characters
+     * \throw if size exceeds Capacity
+     */
+    BasicFixedString(const CharType* data, size_t size);
+
+    /**
+     * \brief Copies a null-terminated sequence of characters
+     * \throw if it is longer than Capacity
+     */
+    BasicFixedString(const CharType* data);
+
+    /**
+     * \brief Copies the bytes of a string
+     * \throw if it is longer than Capacity
+     */
+    BasicFixedString(const std::string& value);
+
+    /**
+     * \brief Returns the maximum number of characters
+     */
+    static constexpr size_t capacity() noexcept;
+
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+    const CharType* data() const noexcept;
+
+    /**
+     * \brief Returns a copy of the bytes of the characters as a string
+     */
+    std::string str() const;
+
+    bool operator==(const BasicFixedString& other) const noexcept;
+    bool operator!=(const BasicFixedString& other) const noexcept;
+
+  private:
+    static size_t length(const CharType* data) noexcept;
+
+  private:
+    CharType m_data[Capacity];
+    uint8_t m_size;
+  };
+
+  /**
+   * \brief Short string stored inline
+   */
+  template <size_t Capacity>
+  using FixedString = BasicFixedString<Capacity, char>;
+
+  /**
+   * \brief Short byte blob stored inline
+   */
+  template <size_t Capacity>
+  using InlineBytes = BasicFixedString<Capacity, unsigned char>;
+
+}
+
+#include <cache/fixed_string.hpp>
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <utility/exceptions.h>
+
+#include <cstring>
+
+namespace cache
+{
+
+  template <size_t Capacity, typename CharType>
+  BasicFixedString<Capacity, CharType>::BasicFixedString() noexcept
+    : m_data()
+    , m_size(0)
+  {
+  }
+
+  template <size_t Capacity, typename CharType>
+  BasicFixedString<Capacity, CharType>::BasicFixedString(const CharType* data, size_t size) try
+    : m_data()
+    , m_size(static_cast<uint8_t>(size))
+  {
+    THROW_IF(size > Capacity, "Value of size = ", size, " exceeds the capacity = ", Capacity, " of a fixed string!");
+
+    std::memcpy(m_data, data, size);
+  }
+  catch (...)
+  {
+    RETHROW("Failed to construct a fixed string!");
+  }
+
+  template <size_t Capacity, typename CharType>
+  BasicFixedString<Capacity, CharType>::BasicFixedString(const CharType* data)
+    : BasicFixedString(data, length(data))
+  {
+  }
+
+  template <size_t Capacity, typename CharType>
+  BasicFixedString<Capacity, CharType>::BasicFixedString(const std::string& value)
+    : BasicFixedString(reinterpret_cast<const CharType*>(value.data()), value.size())
+  {
+  }
+
+  template <size_t Capacity, typename CharType>
+  constexpr size_t BasicFixedString<Capacity, CharType>::capacity() noexcept
+  {
+    return Capacity;
+  }
+
+  template <size_t Capacity, typename CharType>
+  size_t BasicFixedString<Capacity, CharType>::size() const noexcept
+  {
+    return m_size;
+  }
+
+  template <size_t Capacity, typename CharType>
+  bool BasicFixedString<Capacity, CharType>::empty() const noexcept
+  {
+    return m_size == 0;
+  }
+
+  template <size_t Capacity, typename CharType>
+  const CharType* BasicFixedString<Capacity, CharType>::data() const noexcept
+  {
+    return m_data;
+  }
+
+  template <size_t Capacity, typename CharType>
+  std::string BasicFixedString<Capacity, CharType>::str() const
+  {
+    return std::string(reinterpret_cast<const char*>(m_data), m_size);
+  }
+
+  template <size_t Capacity, typename CharType>
+  bool BasicFixedString<Capacity, CharType>::operator==(const BasicFixedString& other) const noexcept
+  {
+    return m_size == other.m_size && std::memcmp(m_data, other.m_data, m_size) == 0;
+  }
+
+  template <size_t Capacity, typename CharType>
+  bool BasicFixedString<Capacity, CharType>::operator!=(const BasicFixedString& other) const noexcept
+  {
+    return !(*this == other);
+  }
+
+  template <size_t Capacity, typename CharType>
+  size_t BasicFixedString<Capacity, CharType>::length(const CharType* data) noexcept
+  {
+    size_t size = 0;
+    while (data[size] != CharType())
+    {
+      ++size;
+    }
+
+    return size;
+  }
+
+}
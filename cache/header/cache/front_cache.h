@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cache/cache.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace cache
+{
+
+  /**
+   * \class FrontCache
+   * \brief Small direct-mapped cache of item pointers in front of a Cache, owned by a single thread
+   * \details Each key maps to a single slot. A repeated lookup of the key held by its slot returns the kept
+   * pointer without locking the cache or searching its index, unless the item has left the cache since (see
+   * Cache::Handle). As hits served by the front cache do not refresh the recency of items in the cache, every
+   * promoteInterval-th hit on a slot goes through the cache instead, so items hot in a thread are not evicted as the
+   * least recently used ones. Evicted items referenced by slots are only released (executing the update hook if
+   * dirty) once their slots are reused or cleared.
+   * Not threadsafe: each thread should own its front cache, which must be destroyed before the cache
+   * \tparam KeyType - type of keys of the cache
+   * \tparam ValueType - type of values of the cache
+   * \tparam UpdateHookType - type of the update hook of the cache
+   * \tparam IndexPolicy - index policy of the cache
+   * \tparam HashType - hash function of the cache, also mapping keys to slots
+   */
+  template <
+    typename KeyType, 
+    typename ValueType, 
+    typename UpdateHookType = UpdateHook<KeyType, ValueType>, 
+    typename IndexPolicy = HashIndexPolicy,
+    typename HashType = Hash<KeyType>
+  >
+  class FrontCache
+  {
+  public:
+    using CacheType = Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>;
+    using ItemPtr = typename CacheType::ItemPtr;
+
+  public:
+    /**
+     * \brief Constructor
+     * \param cache - cache to look keys up in on misses
+     * \param slotCount - number of slots, rounded up to a power of 2
+     * \param promoteInterval - number of consecutive hits on a slot after which the lookup goes through the cache
+     * \throw if slotCount or promoteInterval is 0
+     */
+    FrontCache(CacheType& cache, size_t slotCount = 64, size_t promoteInterval = 16);
+
+    FrontCache(const FrontCache&) = delete;
+    FrontCache& operator=(const FrontCache&) = delete;
+
+    /**
+     * \brief Returns a pointer to the item for a given key (see Cache::operator[])
+     * \details The returned reference stays valid until the next call on the front cache; copy it to keep the item
+     */
+    const ItemPtr& operator[](const KeyType& key);
+
+    /**
+     * \brief Same as operator[], except a null pointer is returned if the key is known to be absent (see Cache::get)
+     */
+    const ItemPtr& get(const KeyType& key);
+
+    /**
+     * \brief Releases all kept item pointers
+     */
+    void clear() noexcept;
+
+    /**
+     * \brief Returns the number of lookups served without accessing the cache
+     */
+    size_t hits() const noexcept;
+
+    /**
+     * \brief Returns the number of lookups forwarded to the cache
+     */
+    size_t misses() const noexcept;
+
+  private:
+    struct Slot
+    {
+      Slot();
+
+      KeyType key;
+      typename CacheType::Handle handle;
+      size_t hits;
+    };
+
+  private:
+    const ItemPtr& access(const KeyType& key, bool skipAbsent);
+    size_t slot_index(const KeyType& key) const;
+
+  private:
+    CacheType& m_cache;
+    std::vector<Slot> m_slots;
+    const size_t m_mask;
+    const size_t m_promoteInterval;
+    size_t m_hits;
+    size_t m_misses;
+  };
+
+  /**
+   * \brief Creates a FrontCache with the types deduced from cache
+   * \param cache - cache to look keys up in on misses
+   * \param slotCount - number of slots, rounded up to a power of 2
+   * \param promoteInterval - number of consecutive hits on a slot after which the lookup goes through the cache
+   */
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  std::unique_ptr<FrontCache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>> make_front_cache(
+    Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>& cache, 
+    size_t slotCount = 64, 
+    size_t promoteInterval = 16
+  );
+
+}
+
+#include <cache/front_cache.hpp>
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <utility/exceptions.h>
+
+#include <cstdint>
+#include <functional>
+
+namespace cache
+{
+
+  namespace detail
+  {
+
+    inline size_t round_up_to_power_of_2(size_t value) noexcept
+    {
+      size_t result = 1;
+      while (result < value)
+      {
+        result <<= 1;
+      }
+
+      return result;
+    }
+
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  FrontCache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::FrontCache(
+    CacheType& cache, 
+    size_t slotCount, 
+    size_t promoteInterval
+  ) try
+    : m_cache(cache)
+    , m_slots(detail::round_up_to_power_of_2(slotCount))
+    , m_mask(m_slots.size() - 1)
+    , m_promoteInterval(promoteInterval)
+    , m_hits(0)
+    , m_misses(0)
+  {
+    THROW_IF(slotCount == 0, "Slot count is 0!");
+    THROW_IF(m_promoteInterval == 0, "Promote interval is 0!");
+  }
+  catch (...)
+  {
+    RETHROW("Failed to construct a FrontCache with slot count = ", slotCount);
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  const typename FrontCache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::ItemPtr& FrontCache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::operator[](
+    const KeyType& key
+  )
+  {
+    return access(key, false);
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  const typename FrontCache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::ItemPtr& FrontCache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::get(
+    const KeyType& key
+  )
+  {
+    return access(key, true);
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  const typename FrontCache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::ItemPtr& FrontCache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::access(
+    const KeyType& key,
+    bool skipAbsent
+  )
+  {
+    auto& slot = m_slots[slot_index(key)];
+
+    if (slot.handle.linked() && slot.key == key && ++slot.hits < m_promoteInterval)
+    {
+      ++m_hits;
+
+      return slot.handle.item();
+    }
+
+    ++m_misses;
+
+    slot.handle = m_cache.lookup(key, skipAbsent);
+    slot.key = key;
+    slot.hits = 0;
+
+    return slot.handle.item();
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  void FrontCache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::clear() noexcept
+  {
+    for (auto& slot : m_slots)
+    {
+      slot.handle = typename CacheType::Handle();
+    }
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  size_t FrontCache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::hits() const noexcept
+  {
+    return m_hits;
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  size_t FrontCache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::misses() const noexcept
+  {
+    return m_misses;
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  size_t FrontCache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::slot_index(const KeyType& key) const
+  {
+    // the upper bits of a multiplicative mix keep consecutive keys from clustering in neighbouring slots
+    auto hash = static_cast<uint64_t>(m_cache.hash_function()(key)) * 0x9E3779B97F4A7C15ull;
+
+    return static_cast<size_t>(hash >> 32) & m_mask;
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  FrontCache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>::Slot::Slot()
+    : key()
+    , hits(0)
+  {
+  }
+
+  template <typename KeyType, typename ValueType, typename UpdateHookType, typename IndexPolicy, typename HashType>
+  std::unique_ptr<FrontCache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>> make_front_cache(
+    Cache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>& cache, 
+    size_t slotCount, 
+    size_t promoteInterval
+  )
+  {
+    return std::make_unique<FrontCache<KeyType, ValueType, UpdateHookType, IndexPolicy, HashType>>(cache, slotCount, promoteInterval);
+  }
+
+}
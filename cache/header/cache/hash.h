@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+namespace cache
+{
+
+  /**
+   * \brief Returns a well-distributed 64-bit mix of a value
+   * \details The finalizer of splitmix64: two multiplications, each followed by a shift, so every bit of the value
+   * affects every bit of the result. Keys differing only in their upper bits or by a constant stride
+   * (e.g. multiples of a power of 2) get unrelated hashes
+   */
+  constexpr uint64_t mix_hash(uint64_t value) noexcept;
+
+  /**
+   * \class Hash
+   * \brief Default hash function of the keys of a Cache
+   * \details Integers, enumerations and pointers are mixed with mix_hash, as std::hash is the identity for them in
+   * common standard libraries, which clusters strided keys in the buckets of hash tables and in shards.
+   * Other keys are hashed by std::hash, which already mixes e.g. the characters of strings
+   * \tparam Key - type of keys
+   */
+  template <typename Key>
+  struct Hash
+  {
+    size_t operator()(const Key& key) const;
+
+  private:
+    static size_t hash(const Key& key, std::true_type) noexcept;
+    static size_t hash(const Key& key, std::false_type);
+  };
+
+}
+
+#include <cache/hash.hpp>
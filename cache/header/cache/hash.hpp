@@ -0,0 +1,32 @@
+#pragma once
+
+namespace cache
+{
+
+  constexpr uint64_t mix_hash(uint64_t value) noexcept
+  {
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+
+    return value ^ (value >> 31);
+  }
+
+  template <typename Key>
+  size_t Hash<Key>::operator()(const Key& key) const
+  {
+    return hash(key, std::integral_constant<bool, std::is_integral<Key>::value || std::is_enum<Key>::value || std::is_pointer<Key>::value>());
+  }
+
+  template <typename Key>
+  size_t Hash<Key>::hash(const Key& key, std::true_type) noexcept
+  {
+    return static_cast<size_t>(mix_hash(static_cast<uint64_t>(std::hash<Key>()(key))));
+  }
+
+  template <typename Key>
+  size_t Hash<Key>::hash(const Key& key, std::false_type)
+  {
+    return std::hash<Key>()(key);
+  }
+
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace cache
+{
+
+  /**
+   * \class HashIndex
+   * \brief Index of cache entries by key backed by a hash table
+   * \details Suits any hashable key. The hash of each key is computed once by the cache and stored in its node,
+   * so rehashing never hashes keys again, and lookups compare stored hashes before keys
+   * \tparam Key - type of keys
+   * \tparam Value - type of indexed values
+   * \tparam Allocator - allocator of index nodes
+   */
+  template <typename Key, typename Value, typename Allocator>
+  class HashIndex
+  {
+  public:
+    /**
+     * \brief Constructor
+     * \param capacity - expected number of keys
+     * \param empty - value standing for an absent key (unused by the hash index)
+     * \param allocator - allocator of index nodes
+     */
+    HashIndex(size_t capacity, const Value& empty, const Allocator& allocator);
+
+    /**
+     * \brief Returns a pointer to the value of a key, or null if the key is absent
+     * \param hash - hash of the key
+     */
+    Value* find(const Key& key, size_t hash);
+
+    /**
+     * \brief Adds an absent key
+     * \param hash - hash of the key
+     */
+    void emplace(const Key& key, size_t hash, const Value& value);
+
+    /**
+     * \brief Removes a key
+     * \param hash - hash of the key
+     * \return false if the key was absent
+     */
+    bool erase(const Key& key, size_t hash);
+
+    /**
+     * \brief Removes all keys, keeping the buckets
+     */
+    void clear() noexcept;
+
+    /**
+     * \brief Returns the number of keys
+     */
+    size_t size() const noexcept;
+
+    /**
+     * \brief Returns an estimate of the memory (in bytes) used by the index
+     */
+    size_t memory() const noexcept;
+
+  private:
+    // the stored hash is the key of the table, so it is neither computed again nor cached twice
+    struct StoredHash
+    {
+      size_t operator()(size_t hash) const noexcept
+      {
+        return hash;
+      }
+    };
+
+    using Map = std::unordered_multimap<
+      size_t, 
+      std::pair<Key, Value>, 
+      StoredHash, 
+      std::equal_to<size_t>, 
+      typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const size_t, std::pair<Key, Value>>>
+    >;
+
+    typename Map::iterator locate(const Key& key, size_t hash);
+
+  private:
+    Map m_map;
+  };
+
+  /**
+   * \class HashIndexPolicy
+   * \brief Selects HashIndex as the index of a Cache
+   */
+  struct HashIndexPolicy
+  {
+    template <typename Key, typename Value, typename Allocator>
+    using Index = HashIndex<Key, Value, Allocator>;
+
+    /**
+     * \brief Returns the value selecting the shard of a key: its hash
+     */
+    template <typename Key>
+    static size_t shard_hash(const Key& key, size_t hash) noexcept;
+  };
+
+}
+
+#include <cache/hash_index.hpp>
@@ -0,0 +1,81 @@
+#pragma once
+
+namespace cache
+{
+
+  template <typename Key, typename Value, typename Allocator>
+  HashIndex<Key, Value, Allocator>::HashIndex(size_t capacity, const Value&, const Allocator& allocator)
+    : m_map(capacity, StoredHash(), std::equal_to<size_t>(), typename Map::allocator_type(allocator))
+  {
+  }
+
+  template <typename Key, typename Value, typename Allocator>
+  Value* HashIndex<Key, Value, Allocator>::find(const Key& key, size_t hash)
+  {
+    auto iter = locate(key, hash);
+
+    return iter == m_map.end() ? nullptr : &iter->second.second;
+  }
+
+  template <typename Key, typename Value, typename Allocator>
+  void HashIndex<Key, Value, Allocator>::emplace(const Key& key, size_t hash, const Value& value)
+  {
+    m_map.emplace(hash, std::make_pair(key, value));
+  }
+
+  template <typename Key, typename Value, typename Allocator>
+  bool HashIndex<Key, Value, Allocator>::erase(const Key& key, size_t hash)
+  {
+    auto iter = locate(key, hash);
+    if (iter == m_map.end())
+    {
+      return false;
+    }
+
+    m_map.erase(iter);
+
+    return true;
+  }
+
+  template <typename Key, typename Value, typename Allocator>
+  void HashIndex<Key, Value, Allocator>::clear() noexcept
+  {
+    m_map.clear();
+  }
+
+  template <typename Key, typename Value, typename Allocator>
+  size_t HashIndex<Key, Value, Allocator>::size() const noexcept
+  {
+    return m_map.size();
+  }
+
+  template <typename Key, typename Value, typename Allocator>
+  size_t HashIndex<Key, Value, Allocator>::memory() const noexcept
+  {
+    // node (link, stored hash, key and value) per key, pointer per bucket
+    return m_map.size() * (sizeof(void*) + sizeof(typename Map::value_type)) + m_map.bucket_count() * sizeof(void*);
+  }
+
+  template <typename Key, typename Value, typename Allocator>
+  typename HashIndex<Key, Value, Allocator>::Map::iterator HashIndex<Key, Value, Allocator>::locate(const Key& key, size_t hash)
+  {
+    auto range = m_map.equal_range(hash);
+
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      if (iter->second.first == key)
+      {
+        return iter;
+      }
+    }
+
+    return m_map.end();
+  }
+
+  template <typename Key>
+  size_t HashIndexPolicy::shard_hash(const Key&, size_t hash) noexcept
+  {
+    return hash;
+  }
+
+}
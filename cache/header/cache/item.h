@@ -1,6 +1,10 @@
 #pragma once
 
+#include <utility/function_ref.h>
+
+#include <atomic>
 #include <memory>
+#include <type_traits>
 
 namespace cache
 {
@@ -20,6 +24,23 @@ namespace cache
      */
     virtual ValueType read() const = 0;
 
+    /**
+     * \brief Atomically passes the value of the item to a function without copying it
+     * \details Lock-based items run function under the shared lock, so it should be short and must not modify
+     * the item. Lock-free items pass a copy of the value, which is cheap for the types they hold
+     * \param function - function taking const ValueType& as argument, passed on by reference without being copied
+     */
+    template <typename Function>
+    void read_with(Function&& function) const;
+
+    /**
+     * \brief Atomically copies the value of the item into an existing object
+     * \details Unlike read, value keeps its resources (e.g. the capacity of a string), so repeated reads into the
+     * same object need not allocate
+     * \param value - object to assign the value of the item to
+     */
+    virtual void read_into(ValueType& value) const = 0;
+
     /**
      * \brief Atomically updates the value in the item
      */
@@ -35,19 +56,132 @@ namespace cache
      * \details No updates are made in case the current value is different from expected
      * \param expected - expected current value
      * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was updated
      */
-    virtual void compare_exchange(const ValueType& expected, const ValueType& desired) = 0;
+    virtual bool compare_exchange(const ValueType& expected, const ValueType& desired) = 0;
 
     /**
      * \brief Atomically updates the value with desired in case it is currently equal to expected
      * \details No updates are made in case the current value is different from expected
      * \param expected - expected current value
      * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was updated
+     */
+    virtual bool compare_exchange(const ValueType& expected, ValueType&& desired) = 0;
+
+    /**
+     * \brief Atomically fills the item with desired in case it is currently equal to expected
+     * \details Same as compare_exchange, except the item is not marked dirty. Used to store values loaded
+     * from the backing storage, which need not be written back
+     * \param expected - expected current value
+     * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was filled
+     */
+    virtual bool populate(const ValueType& expected, const ValueType& desired) = 0;
+
+    /**
+     * \brief Atomically fills the item with desired in case it is currently equal to expected
+     * \details Same as compare_exchange, except the item is not marked dirty. Used to store values loaded
+     * from the backing storage, which need not be written back
+     * \param expected - expected current value
+     * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was filled
+     */
+    virtual bool populate(const ValueType& expected, ValueType&& desired) = 0;
+
+    /**
+     * \brief Atomically replaces the value with the result of a function applied to it
+     * \details Lock-based items apply function once under a single lock acquisition, while lock-free items
+     * apply it until no concurrent modification intervenes, so function must have no side effects.
+     * Nothing is modified if function throws
+     * \param function - function computing the new value from the current one, passed on by reference without
+     * being copied
+     * \return previous value
+     */
+    template <typename Function>
+    ValueType fetch_update(Function&& function);
+
+    /**
+     * \brief Atomically adds delta to the value
+     * \details Lock-free items of integral types use a single atomic addition
+     * \return previous value
+     */
+    template <typename T = ValueType, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+    ValueType fetch_add(const ValueType& delta);
+
+    /**
+     * \brief Returns true if the value has been modified by update, compare_exchange or fetch_update since the item
+     * was created or last cleaned
+     */
+    bool dirty() const noexcept;
+
+    /**
+     * \brief Atomically clears the dirty flag
+     * \return true if the item was dirty
+     */
+    bool clean() noexcept;
+
+    /**
+     * \brief Returns true if the item holds a loaded value rather than the default value it was created with
+     * \details Set by a successful populate, by modifications, and by mark_loaded. Unlike comparing the value with
+     * the default one, this tells loaded values equal to the default value apart
+     */
+    bool loaded() const noexcept;
+
+    /**
+     * \brief Marks the item as holding a loaded value
+     * \details Used for items created with a known value (e.g. by Cache::insert or restore)
      */
-    virtual void compare_exchange(const ValueType& expected, ValueType&& desired) = 0;
+    void mark_loaded() noexcept;
 
     virtual ~Item() = default;
+
+  protected:
+    /**
+     * \class Reader
+     * \brief Non-owning reference to the function passed to read_with
+     */
+    using Reader = utility::FunctionRef<void(const ValueType&)>;
+
+    /**
+     * \class Updater
+     * \brief Non-owning reference to the function passed to fetch_update
+     */
+    using Updater = utility::FunctionRef<ValueType(const ValueType&)>;
+
+  protected:
+    Item() = default;
+
+    /**
+     * \brief Marks the item dirty (and loaded)
+     * \details Must be called by implementations after the value has been modified
+     */
+    void mark_dirty() noexcept;
+
+    /**
+     * \brief Atomically adds delta to the value if the implementation has an atomic addition for ValueType
+     * \param previous - set to the previous value if the addition took place
+     * \return true if the addition took place, false if it must be emulated with fetch_update
+     */
+    virtual bool native_fetch_add(const ValueType& delta, ValueType& previous);
+
+    /**
+     * \brief Atomically passes the value of the item to the function referenced by reader (see read_with)
+     */
+    virtual void read_with_reader(Reader reader) const = 0;
+
+    /**
+     * \brief Atomically replaces the value with the result of the function referenced by updater (see fetch_update)
+     * \return previous value
+     */
+    virtual ValueType fetch_update_with(Updater updater) = 0;
+
+  private:
+    std::atomic<bool> m_dirty { false };
+    std::atomic<bool> m_loaded { false };
   };
 
 }
 
+#include <cache/item.hpp>
+
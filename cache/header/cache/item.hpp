@@ -0,0 +1,74 @@
+#pragma once
+
+namespace cache
+{
+
+  template <typename ValueType>
+  template <typename Function>
+  void Item<ValueType>::read_with(Function&& function) const
+  {
+    read_with_reader(Reader(function));
+  }
+
+  template <typename ValueType>
+  template <typename Function>
+  ValueType Item<ValueType>::fetch_update(Function&& function)
+  {
+    return fetch_update_with(Updater(function));
+  }
+
+  template <typename ValueType>
+  template <typename T, typename>
+  ValueType Item<ValueType>::fetch_add(const ValueType& delta)
+  {
+    ValueType previous;
+    if (native_fetch_add(delta, previous))
+    {
+      return previous;
+    }
+
+    return fetch_update([&delta] (const ValueType& value) { return static_cast<ValueType>(value + delta); });
+  }
+
+  template <typename ValueType>
+  bool Item<ValueType>::dirty() const noexcept
+  {
+    return m_dirty.load(std::memory_order_acquire);
+  }
+
+  template <typename ValueType>
+  bool Item<ValueType>::clean() noexcept
+  {
+    return m_dirty.exchange(false, std::memory_order_acq_rel);
+  }
+
+  template <typename ValueType>
+  bool Item<ValueType>::loaded() const noexcept
+  {
+    return m_loaded.load(std::memory_order_acquire);
+  }
+
+  template <typename ValueType>
+  void Item<ValueType>::mark_loaded() noexcept
+  {
+    // the flag is only set once, so hot items are not written to on each modification
+    if (!m_loaded.load(std::memory_order_relaxed))
+    {
+      m_loaded.store(true, std::memory_order_release);
+    }
+  }
+
+  template <typename ValueType>
+  void Item<ValueType>::mark_dirty() noexcept
+  {
+    mark_loaded();
+    m_dirty.store(true, std::memory_order_release);
+  }
+
+  template <typename ValueType>
+  bool Item<ValueType>::native_fetch_add(const ValueType&, ValueType&)
+  {
+    return false;
+  }
+
+}
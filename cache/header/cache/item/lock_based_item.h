@@ -32,6 +32,11 @@ namespace cache
      */
     virtual ValueType read() const override final;
 
+    /**
+     * \brief Atomically copies the value of the item into an existing object
+     */
+    virtual void read_into(ValueType& value) const override final;
+
     /**
      * \brief Atomically updates the value in the item
      */
@@ -47,18 +52,51 @@ namespace cache
      * \details No updates are made in case the current value is different from expected
      * \param expected - expected current value
      * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was updated
      */
-    virtual void compare_exchange(const ValueType& expected, const ValueType& desired) override final;
+    virtual bool compare_exchange(const ValueType& expected, const ValueType& desired) override final;
 
     /**
      * \brief Atomically updates the value with desired in case it is currently equal to expected
      * \details No updates are made in case the current value is different from expected
      * \param expected - expected current value
      * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was updated
+     */
+    virtual bool compare_exchange(const ValueType& expected, ValueType&& desired) override final;
+
+    /**
+     * \brief Atomically fills the item with desired in case it is currently equal to expected
+     * \details Same as compare_exchange, except the item is not marked dirty
+     * \param expected - expected current value
+     * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was filled
      */
-    virtual void compare_exchange(const ValueType& expected, ValueType&& desired) override final;
+    virtual bool populate(const ValueType& expected, const ValueType& desired) override final;
+
+    /**
+     * \brief Atomically fills the item with desired in case it is currently equal to expected
+     * \details Same as compare_exchange, except the item is not marked dirty
+     * \param expected - expected current value
+     * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was filled
+     */
+    virtual bool populate(const ValueType& expected, ValueType&& desired) override final;
 
   protected:
+    /**
+     * \brief Atomically passes the value of the item to the function referenced by reader
+     * \details reader runs under the shared lock
+     */
+    virtual void read_with_reader(typename Item<ValueType>::Reader reader) const override final;
+
+    /**
+     * \brief Atomically replaces the value with the result of the function referenced by updater
+     * \details updater is applied once under the unique lock
+     * \return previous value
+     */
+    virtual ValueType fetch_update_with(typename Item<ValueType>::Updater updater) override final;
+
     ValueType m_value;
     std::unique_ptr<LockPolicy> m_lockPolicy;
   };
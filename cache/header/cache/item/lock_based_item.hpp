@@ -19,12 +19,29 @@ namespace cache
     return m_value;
   }
 
+  template <typename ValueType>
+  void LockBasedItem<ValueType>::read_with_reader(typename Item<ValueType>::Reader reader) const
+  {
+    auto lock = m_lockPolicy->acquire_shared_lock();
+
+    reader(m_value);
+  }
+
+  template <typename ValueType>
+  void LockBasedItem<ValueType>::read_into(ValueType& value) const
+  {
+    auto lock = m_lockPolicy->acquire_shared_lock();
+
+    value = m_value;
+  }
+
   template <typename ValueType>
   void LockBasedItem<ValueType>::update(const ValueType& value)
   {
     auto lock = m_lockPolicy->acquire_unique_lock();
 
     m_value = value;
+    this->mark_dirty();
   }
 
   template <typename ValueType>
@@ -33,28 +50,85 @@ namespace cache
     auto lock = m_lockPolicy->acquire_unique_lock();
 
     m_value = std::move(value);
+    this->mark_dirty();
+  }
+
+  template <typename ValueType>
+  bool LockBasedItem<ValueType>::compare_exchange(const ValueType& expected, const ValueType& desired)
+  {
+    auto lock = m_lockPolicy->acquire_unique_lock();
+
+    if (m_value == expected)
+    {
+      m_value = desired;
+      this->mark_dirty();
+
+      return true;
+    }
+
+    return false;
   }
 
   template <typename ValueType>
-  void LockBasedItem<ValueType>::compare_exchange(const ValueType& expected, const ValueType& desired)
+  bool LockBasedItem<ValueType>::compare_exchange(const ValueType& expected, ValueType&& desired)
+  {
+    auto lock = m_lockPolicy->acquire_unique_lock();
+
+    if (m_value == expected)
+    {
+      m_value = std::move(desired);
+      this->mark_dirty();
+
+      return true;
+    }
+
+    return false;
+  }
+
+  template <typename ValueType>
+  bool LockBasedItem<ValueType>::populate(const ValueType& expected, const ValueType& desired)
   {
     auto lock = m_lockPolicy->acquire_unique_lock();
 
     if (m_value == expected)
     {
       m_value = desired;
+      this->mark_loaded();
+
+      return true;
     }
+
+    return false;
   }
 
   template <typename ValueType>
-  void LockBasedItem<ValueType>::compare_exchange(const ValueType& expected, ValueType&& desired)
+  bool LockBasedItem<ValueType>::populate(const ValueType& expected, ValueType&& desired)
   {
     auto lock = m_lockPolicy->acquire_unique_lock();
 
     if (m_value == expected)
     {
       m_value = std::move(desired);
+      this->mark_loaded();
+
+      return true;
     }
+
+    return false;
+  }
+
+  template <typename ValueType>
+  ValueType LockBasedItem<ValueType>::fetch_update_with(typename Item<ValueType>::Updater updater)
+  {
+    auto lock = m_lockPolicy->acquire_unique_lock();
+
+    auto desired = updater(m_value);
+    auto previous = std::move(m_value);
+
+    m_value = std::move(desired);
+    this->mark_dirty();
+
+    return previous;
   }
 
 }
@@ -31,6 +31,11 @@ namespace cache
      */
     virtual ValueType read() const override final;
 
+    /**
+     * \brief Atomically copies the value of the item into an existing object
+     */
+    virtual void read_into(ValueType& value) const override final;
+
     /**
      * \brief Atomically updates the value in the item
      */
@@ -46,16 +51,60 @@ namespace cache
      * \details No updates are made in case the current value is different from expected
      * \param expected - expected current value
      * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was updated
      */
-    virtual void compare_exchange(const ValueType& expected, const ValueType& desired) override final;
+    virtual bool compare_exchange(const ValueType& expected, const ValueType& desired) override final;
 
     /**
      * \brief Atomically updates the value with desired in case it is currently equal to expected
      * \details No updates are made in case the current value is different from expected
      * \param expected - expected current value
      * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was updated
+     */
+    virtual bool compare_exchange(const ValueType& expected, ValueType&& desired) override final;
+
+    /**
+     * \brief Atomically fills the item with desired in case it is currently equal to expected
+     * \details Same as compare_exchange, except the item is not marked dirty
+     * \param expected - expected current value
+     * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was filled
+     */
+    virtual bool populate(const ValueType& expected, const ValueType& desired) override final;
+
+    /**
+     * \brief Atomically fills the item with desired in case it is currently equal to expected
+     * \details Same as compare_exchange, except the item is not marked dirty
+     * \param expected - expected current value
+     * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was filled
+     */
+    virtual bool populate(const ValueType& expected, ValueType&& desired) override final;
+
+  protected:
+    /**
+     * \brief Atomically passes the value of the item to the function referenced by reader
+     * \details reader is passed a copy of the value
+     */
+    virtual void read_with_reader(typename Item<ValueType>::Reader reader) const override final;
+
+    /**
+     * \brief Atomically replaces the value with the result of the function referenced by updater
+     * \details updater is applied to the last value read until the value is swapped without a concurrent modification,
+     * so it may be called more than once
+     * \return previous value
+     */
+    virtual ValueType fetch_update_with(typename Item<ValueType>::Updater updater) override final;
+
+    /**
+     * \brief Atomically adds delta to the value if ValueType is integral
      */
-    virtual void compare_exchange(const ValueType& expected, ValueType&& desired) override final;
+    virtual bool native_fetch_add(const ValueType& delta, ValueType& previous) override final;
+
+  private:
+    bool native_fetch_add(const ValueType& delta, ValueType& previous, std::true_type);
+    bool native_fetch_add(const ValueType& delta, ValueType& previous, std::false_type);
 
   private:
     std::atomic<ValueType> m_value;
@@ -6,8 +6,8 @@ namespace cache
   template <typename ValueType>
   template <typename ValueTypeFwd>
   LockFreeItem<ValueType>::LockFreeItem(ValueTypeFwd&& value)
+    : m_value(std::forward<ValueTypeFwd>(value))
   {
-    update(std::forward<ValueTypeFwd>(value));
   }
 
   template <typename ValueType>
@@ -16,32 +16,125 @@ namespace cache
     return m_value.load();
   }
 
+  template <typename ValueType>
+  void LockFreeItem<ValueType>::read_with_reader(typename Item<ValueType>::Reader reader) const
+  {
+    reader(m_value.load());
+  }
+
+  template <typename ValueType>
+  void LockFreeItem<ValueType>::read_into(ValueType& value) const
+  {
+    value = m_value.load();
+  }
+
   template <typename ValueType>
   void LockFreeItem<ValueType>::update(const ValueType& value)
   {
     m_value.store(value);
+    this->mark_dirty();
   }
 
   template <typename ValueType>
   void LockFreeItem<ValueType>::update(ValueType&& value)
   {
     m_value.store(std::move(value));
+    this->mark_dirty();
   }
 
   template <typename ValueType>
-  void LockFreeItem<ValueType>::compare_exchange(const ValueType& expected, const ValueType& desired)
+  bool LockFreeItem<ValueType>::compare_exchange(const ValueType& expected, const ValueType& desired)
   {
     auto expectedAdaptor = expected;
 
-    m_value.compare_exchange_strong(expectedAdaptor, desired);
+    if (m_value.compare_exchange_strong(expectedAdaptor, desired))
+    {
+      this->mark_dirty();
+
+      return true;
+    }
+
+    return false;
   }
 
   template <typename ValueType>
-  void LockFreeItem<ValueType>::compare_exchange(const ValueType& expected, ValueType&& desired)
+  bool LockFreeItem<ValueType>::compare_exchange(const ValueType& expected, ValueType&& desired)
   {
     auto expectedAdaptor = expected;
     
-    m_value.compare_exchange_strong(expectedAdaptor, desired);
+    if (m_value.compare_exchange_strong(expectedAdaptor, desired))
+    {
+      this->mark_dirty();
+
+      return true;
+    }
+
+    return false;
+  }
+
+  template <typename ValueType>
+  bool LockFreeItem<ValueType>::populate(const ValueType& expected, const ValueType& desired)
+  {
+    auto expectedAdaptor = expected;
+
+    if (m_value.compare_exchange_strong(expectedAdaptor, desired))
+    {
+      this->mark_loaded();
+
+      return true;
+    }
+
+    return false;
+  }
+
+  template <typename ValueType>
+  bool LockFreeItem<ValueType>::populate(const ValueType& expected, ValueType&& desired)
+  {
+    auto expectedAdaptor = expected;
+
+    if (m_value.compare_exchange_strong(expectedAdaptor, desired))
+    {
+      this->mark_loaded();
+
+      return true;
+    }
+
+    return false;
+  }
+
+  template <typename ValueType>
+  ValueType LockFreeItem<ValueType>::fetch_update_with(typename Item<ValueType>::Updater updater)
+  {
+    auto previous = m_value.load();
+
+    while (!m_value.compare_exchange_weak(previous, updater(previous)))
+    {
+    }
+
+    this->mark_dirty();
+
+    return previous;
+  }
+
+  template <typename ValueType>
+  bool LockFreeItem<ValueType>::native_fetch_add(const ValueType& delta, ValueType& previous)
+  {
+    return native_fetch_add(delta, previous, std::integral_constant<bool, std::is_integral<ValueType>::value && !std::is_same<ValueType, bool>::value>());
+  }
+
+  template <typename ValueType>
+  bool LockFreeItem<ValueType>::native_fetch_add(const ValueType& delta, ValueType& previous, std::true_type)
+  {
+    previous = m_value.fetch_add(delta);
+    this->mark_dirty();
+
+    return true;
+  }
+
+  template <typename ValueType>
+  bool LockFreeItem<ValueType>::native_fetch_add(const ValueType&, ValueType&, std::false_type)
+  {
+    return false;
   }
 
 }
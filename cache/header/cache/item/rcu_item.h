@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cache/item.h>
+#include <cache/lock_policy.h>
+
+#include <utility/epoch.h>
+
+#include <atomic>
+#include <memory>
+
+namespace cache
+{
+
+  /**
+   * \brief Returns the epoch domain shared by all RcuItems
+   */
+  utility::EpochDomain& rcu_domain();
+
+  /**
+   * \brief Returns the LockProfile of the writer locks of all RcuItems
+   */
+  utility::LockProfileRef rcu_lock_profile();
+
+  /**
+   * \class RcuItem
+   * \brief Publishes immutable versions of the value, read without locking
+   * \details Readers pin the epoch of rcu_domain and read the current version through an atomic pointer, so reads
+   * never wait for writers nor for each other. Writers are serialized by a unique lock, publish a new version and retire
+   * the previous one, which is released once no reader can still be reading it.
+   * Every write allocates a version, so the item suits values read much more often than written.
+   * All non-special member functions are threadsafe
+   * \tparam ValueType - type of elements in the cache
+   */
+  template <typename ValueType>
+  class RcuItem : public Item<ValueType>
+  {
+  public:
+    /**
+     * \brief Constructor
+     * \param value - initial value to store in the item
+     */
+    template <typename ValueTypeFwd>
+    explicit RcuItem(ValueTypeFwd&& value);
+
+    /**
+     * \brief Atomically retrieves the value from the item
+     */
+    virtual ValueType read() const override final;
+
+    /**
+     * \brief Atomically copies the value of the item into an existing object
+     */
+    virtual void read_into(ValueType& value) const override final;
+
+    /**
+     * \brief Atomically updates the value in the item
+     */
+    virtual void update(const ValueType& value) override final;
+
+    /**
+     * \brief Atomically updates the value in the item
+     */
+    virtual void update(ValueType&& value) override final;
+
+    /**
+     * \brief Atomically updates the value with desired in case it is currently equal to expected
+     * \details No updates are made in case the current value is different from expected
+     * \param expected - expected current value
+     * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was updated
+     */
+    virtual bool compare_exchange(const ValueType& expected, const ValueType& desired) override final;
+
+    /**
+     * \brief Atomically updates the value with desired in case it is currently equal to expected
+     * \details No updates are made in case the current value is different from expected
+     * \param expected - expected current value
+     * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was updated
+     */
+    virtual bool compare_exchange(const ValueType& expected, ValueType&& desired) override final;
+
+    /**
+     * \brief Atomically fills the item with desired in case it is currently equal to expected
+     * \details Same as compare_exchange, except the item is not marked dirty
+     * \param expected - expected current value
+     * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was filled
+     */
+    virtual bool populate(const ValueType& expected, const ValueType& desired) override final;
+
+    /**
+     * \brief Atomically fills the item with desired in case it is currently equal to expected
+     * \details Same as compare_exchange, except the item is not marked dirty
+     * \param expected - expected current value
+     * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was filled
+     */
+    virtual bool populate(const ValueType& expected, ValueType&& desired) override final;
+
+  protected:
+    /**
+     * \brief Atomically passes the value of the item to the function referenced by reader
+     * \details reader runs on the current version without any lock, so it may run concurrently with writes
+     */
+    virtual void read_with_reader(typename Item<ValueType>::Reader reader) const override final;
+
+    /**
+     * \brief Atomically replaces the value with the result of the function referenced by updater
+     * \details updater is applied once under the unique lock of writers
+     * \return previous value
+     */
+    virtual ValueType fetch_update_with(typename Item<ValueType>::Updater updater) override final;
+
+  private:
+    using Version = std::shared_ptr<const ValueType>;
+
+    /**
+     * \brief Publishes a new version, the unique lock of writers being held
+     * \return previous version, to be retired once the lock is released
+     */
+    template <typename ValueTypeFwd>
+    Version publish(ValueTypeFwd&& value);
+
+  private:
+    Version m_current;                       ///< owner of the published version, only accessed by writers
+    std::atomic<const ValueType*> m_published;
+    std::unique_ptr<LockPolicy> m_lockPolicy;
+  };
+
+}
+
+#include <cache/item/rcu_item.hpp>
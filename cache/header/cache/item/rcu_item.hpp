@@ -0,0 +1,188 @@
+#pragma once
+
+namespace cache
+{
+
+  template <typename ValueType>
+  template <typename ValueTypeFwd>
+  RcuItem<ValueType>::RcuItem(ValueTypeFwd&& value)
+    : m_current(std::make_shared<const ValueType>(std::forward<ValueTypeFwd>(value)))
+    , m_published(m_current.get())
+    , m_lockPolicy(make_lock_policy(true, rcu_lock_profile()))
+  {
+  }
+
+  template <typename ValueType>
+  ValueType RcuItem<ValueType>::read() const
+  {
+    auto guard = rcu_domain().pin();
+
+    return *m_published.load(std::memory_order_acquire);
+  }
+
+  template <typename ValueType>
+  void RcuItem<ValueType>::read_with_reader(typename Item<ValueType>::Reader reader) const
+  {
+    auto guard = rcu_domain().pin();
+
+    reader(*m_published.load(std::memory_order_acquire));
+  }
+
+  template <typename ValueType>
+  void RcuItem<ValueType>::read_into(ValueType& value) const
+  {
+    auto guard = rcu_domain().pin();
+
+    value = *m_published.load(std::memory_order_acquire);
+  }
+
+  template <typename ValueType>
+  void RcuItem<ValueType>::update(const ValueType& value)
+  {
+    Version previous;
+
+    {
+      auto lock = m_lockPolicy->acquire_unique_lock();
+
+      previous = publish(value);
+      this->mark_dirty();
+    }
+
+    rcu_domain().retire(std::move(previous));
+  }
+
+  template <typename ValueType>
+  void RcuItem<ValueType>::update(ValueType&& value)
+  {
+    Version previous;
+
+    {
+      auto lock = m_lockPolicy->acquire_unique_lock();
+
+      previous = publish(std::move(value));
+      this->mark_dirty();
+    }
+
+    rcu_domain().retire(std::move(previous));
+  }
+
+  template <typename ValueType>
+  bool RcuItem<ValueType>::compare_exchange(const ValueType& expected, const ValueType& desired)
+  {
+    Version previous;
+
+    {
+      auto lock = m_lockPolicy->acquire_unique_lock();
+
+      if (!(*m_current == expected))
+      {
+        return false;
+      }
+
+      previous = publish(desired);
+      this->mark_dirty();
+    }
+
+    rcu_domain().retire(std::move(previous));
+
+    return true;
+  }
+
+  template <typename ValueType>
+  bool RcuItem<ValueType>::compare_exchange(const ValueType& expected, ValueType&& desired)
+  {
+    Version previous;
+
+    {
+      auto lock = m_lockPolicy->acquire_unique_lock();
+
+      if (!(*m_current == expected))
+      {
+        return false;
+      }
+
+      previous = publish(std::move(desired));
+      this->mark_dirty();
+    }
+
+    rcu_domain().retire(std::move(previous));
+
+    return true;
+  }
+
+  template <typename ValueType>
+  bool RcuItem<ValueType>::populate(const ValueType& expected, const ValueType& desired)
+  {
+    Version previous;
+
+    {
+      auto lock = m_lockPolicy->acquire_unique_lock();
+
+      if (!(*m_current == expected))
+      {
+        return false;
+      }
+
+      previous = publish(desired);
+    }
+
+    this->mark_loaded();
+    rcu_domain().retire(std::move(previous));
+
+    return true;
+  }
+
+  template <typename ValueType>
+  bool RcuItem<ValueType>::populate(const ValueType& expected, ValueType&& desired)
+  {
+    Version previous;
+
+    {
+      auto lock = m_lockPolicy->acquire_unique_lock();
+
+      if (!(*m_current == expected))
+      {
+        return false;
+      }
+
+      previous = publish(std::move(desired));
+    }
+
+    this->mark_loaded();
+    rcu_domain().retire(std::move(previous));
+
+    return true;
+  }
+
+  template <typename ValueType>
+  ValueType RcuItem<ValueType>::fetch_update_with(typename Item<ValueType>::Updater updater)
+  {
+    Version previous;
+
+    {
+      auto lock = m_lockPolicy->acquire_unique_lock();
+
+      previous = publish(updater(*m_current));
+      this->mark_dirty();
+    }
+
+    auto result = *previous;
+
+    rcu_domain().retire(std::move(previous));
+
+    return result;
+  }
+
+  template <typename ValueType>
+  template <typename ValueTypeFwd>
+  typename RcuItem<ValueType>::Version RcuItem<ValueType>::publish(ValueTypeFwd&& value)
+  {
+    auto version = std::make_shared<const ValueType>(std::forward<ValueTypeFwd>(value));
+
+    m_published.store(version.get(), std::memory_order_release);
+    m_current.swap(version);
+
+    return version;
+  }
+
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cache/item.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace cache
+{
+
+  /**
+   * \class SeqLockItem
+   * \brief Stores a trivially copyable value inline, read without locking under a sequence lock
+   * \details Writers are serialized by a sequence counter, odd while a write is in progress. Readers copy the value and
+   * retry if the counter was odd or changed meanwhile, so reads never write to the item nor wait for each other.
+   * Suits values too large for lock-free atomic operations but small enough to be copied cheaply, such as FixedString.
+   * All non-special member functions are threadsafe
+   * \tparam ValueType - type of elements in the cache
+   */
+  template <typename ValueType>
+  class SeqLockItem : public Item<ValueType>
+  {
+    static_assert(std::is_trivially_copyable<ValueType>::value, "SeqLockItem requires a trivially copyable type!");
+    static_assert(alignof(ValueType) <= alignof(uint64_t), "SeqLockItem does not support over-aligned types!");
+
+  public:
+    /**
+     * \brief Constructor
+     * \param value - initial value to store in the item
+     */
+    template <typename ValueTypeFwd>
+    explicit SeqLockItem(ValueTypeFwd&& value);
+
+    /**
+     * \brief Atomically retrieves the value from the item
+     */
+    virtual ValueType read() const override final;
+
+    /**
+     * \brief Atomically copies the value of the item into an existing object
+     */
+    virtual void read_into(ValueType& value) const override final;
+
+    /**
+     * \brief Atomically updates the value in the item
+     */
+    virtual void update(const ValueType& value) override final;
+
+    /**
+     * \brief Atomically updates the value in the item
+     */
+    virtual void update(ValueType&& value) override final;
+
+    /**
+     * \brief Atomically updates the value with desired in case it is currently equal to expected
+     * \details No updates are made in case the current value is different from expected
+     * \param expected - expected current value
+     * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was updated
+     */
+    virtual bool compare_exchange(const ValueType& expected, const ValueType& desired) override final;
+
+    /**
+     * \brief Atomically updates the value with desired in case it is currently equal to expected
+     * \details No updates are made in case the current value is different from expected
+     * \param expected - expected current value
+     * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was updated
+     */
+    virtual bool compare_exchange(const ValueType& expected, ValueType&& desired) override final;
+
+    /**
+     * \brief Atomically fills the item with desired in case it is currently equal to expected
+     * \details Same as compare_exchange, except the item is not marked dirty
+     * \param expected - expected current value
+     * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was filled
+     */
+    virtual bool populate(const ValueType& expected, const ValueType& desired) override final;
+
+    /**
+     * \brief Atomically fills the item with desired in case it is currently equal to expected
+     * \details Same as compare_exchange, except the item is not marked dirty
+     * \param expected - expected current value
+     * \param desired - new value to update the item with in case the current value == expected
+     * \return true if the item was filled
+     */
+    virtual bool populate(const ValueType& expected, ValueType&& desired) override final;
+
+  protected:
+    /**
+     * \brief Atomically passes the value of the item to the function referenced by reader
+     * \details reader is passed a copy of the value
+     */
+    virtual void read_with_reader(typename Item<ValueType>::Reader reader) const override final;
+
+    /**
+     * \brief Atomically replaces the value with the result of the function referenced by updater
+     * \details updater is called once, while other writers wait
+     * \return previous value
+     */
+    virtual ValueType fetch_update_with(typename Item<ValueType>::Updater updater) override final;
+
+  private:
+    static constexpr size_t WordCount = (sizeof(ValueType) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    static constexpr size_t SpinLimit = 64;  ///< failed attempts to lock before yielding
+
+    using Words = std::array<uint64_t, WordCount>;
+
+    /**
+     * \class WriteLock
+     * \brief Makes the sequence odd for its lifetime, so readers retry
+     */
+    class WriteLock
+    {
+    public:
+      explicit WriteLock(SeqLockItem& item) noexcept;
+      ~WriteLock();
+
+    private:
+      SeqLockItem& m_item;
+      uint64_t m_sequence;
+    };
+
+    /**
+     * \brief Copies the words of the value, which may be torn unless the write lock is held
+     */
+    Words load() const noexcept;
+
+    /**
+     * \brief Stores the words of a value, the write lock being held
+     */
+    void store(const ValueType& value) noexcept;
+
+    /**
+     * \brief Copies a value out of its words
+     * \details The bytes are copied rather than the words being accessed as ValueType, which would break strict aliasing
+     */
+    static ValueType to_value(const Words& words) noexcept;
+
+    /**
+     * \brief Copies a value into words, the unused bytes of which are zeroed
+     */
+    static Words from_value(const ValueType& value) noexcept;
+
+  private:
+    std::atomic<uint64_t> m_sequence;
+    std::array<std::atomic<uint64_t>, WordCount> m_words;
+  };
+
+}
+
+#include <cache/item/seq_lock_item.hpp>
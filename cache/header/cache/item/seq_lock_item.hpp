@@ -0,0 +1,211 @@
+#pragma once
+
+#include <cstring>
+#include <thread>
+
+namespace cache
+{
+
+  template <typename ValueType>
+  SeqLockItem<ValueType>::WriteLock::WriteLock(SeqLockItem& item) noexcept
+    : m_item(item)
+    , m_sequence(item.m_sequence.load(std::memory_order_relaxed))
+  {
+    for (size_t attempts = 1; ; ++attempts)
+    {
+      if (m_sequence % 2 == 0 && 
+        m_item.m_sequence.compare_exchange_weak(m_sequence, m_sequence + 1, std::memory_order_acquire, std::memory_order_relaxed))
+      {
+        break;
+      }
+
+      if (attempts % SpinLimit == 0)
+      {
+        std::this_thread::yield();
+      }
+
+      m_sequence = m_item.m_sequence.load(std::memory_order_relaxed);
+    }
+
+    // The odd sequence must be visible before any word is modified
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  template <typename ValueType>
+  SeqLockItem<ValueType>::WriteLock::~WriteLock()
+  {
+    m_item.m_sequence.store(m_sequence + 2, std::memory_order_release);
+  }
+
+  template <typename ValueType>
+  template <typename ValueTypeFwd>
+  SeqLockItem<ValueType>::SeqLockItem(ValueTypeFwd&& value)
+    : m_sequence(0)
+  {
+    store(value);
+  }
+
+  template <typename ValueType>
+  ValueType SeqLockItem<ValueType>::read() const
+  {
+    for (size_t attempts = 1; ; ++attempts)
+    {
+      auto sequence = m_sequence.load(std::memory_order_acquire);
+
+      if (sequence % 2 == 0)
+      {
+        auto words = load();
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (m_sequence.load(std::memory_order_relaxed) == sequence)
+        {
+          return to_value(words);
+        }
+      }
+
+      if (attempts % SpinLimit == 0)
+      {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  template <typename ValueType>
+  void SeqLockItem<ValueType>::read_with_reader(typename Item<ValueType>::Reader reader) const
+  {
+    reader(read());
+  }
+
+  template <typename ValueType>
+  void SeqLockItem<ValueType>::read_into(ValueType& value) const
+  {
+    value = read();
+  }
+
+  template <typename ValueType>
+  void SeqLockItem<ValueType>::update(const ValueType& value)
+  {
+    {
+      WriteLock lock(*this);
+      store(value);
+    }
+
+    this->mark_dirty();
+  }
+
+  template <typename ValueType>
+  void SeqLockItem<ValueType>::update(ValueType&& value)
+  {
+    update(static_cast<const ValueType&>(value));
+  }
+
+  template <typename ValueType>
+  bool SeqLockItem<ValueType>::compare_exchange(const ValueType& expected, const ValueType& desired)
+  {
+    if (populate(expected, desired))
+    {
+      this->mark_dirty();
+
+      return true;
+    }
+
+    return false;
+  }
+
+  template <typename ValueType>
+  bool SeqLockItem<ValueType>::compare_exchange(const ValueType& expected, ValueType&& desired)
+  {
+    return compare_exchange(expected, static_cast<const ValueType&>(desired));
+  }
+
+  template <typename ValueType>
+  bool SeqLockItem<ValueType>::populate(const ValueType& expected, const ValueType& desired)
+  {
+    WriteLock lock(*this);
+
+    if (to_value(load()) == expected)
+    {
+      store(desired);
+      this->mark_loaded();
+
+      return true;
+    }
+
+    return false;
+  }
+
+  template <typename ValueType>
+  bool SeqLockItem<ValueType>::populate(const ValueType& expected, ValueType&& desired)
+  {
+    return populate(expected, static_cast<const ValueType&>(desired));
+  }
+
+  template <typename ValueType>
+  ValueType SeqLockItem<ValueType>::fetch_update_with(typename Item<ValueType>::Updater updater)
+  {
+    auto previous = [this, &updater]()
+    {
+      WriteLock lock(*this);
+      auto value = to_value(load());
+
+      store(updater(value));
+
+      return value;
+    }();
+
+    this->mark_dirty();
+
+    return previous;
+  }
+
+  template <typename ValueType>
+  typename SeqLockItem<ValueType>::Words SeqLockItem<ValueType>::load() const noexcept
+  {
+    Words words;
+
+    for (size_t i = 0; i < WordCount; ++i)
+    {
+      words[i] = m_words[i].load(std::memory_order_relaxed);
+    }
+
+    return words;
+  }
+
+  template <typename ValueType>
+  void SeqLockItem<ValueType>::store(const ValueType& value) noexcept
+  {
+    auto words = from_value(value);
+
+    for (size_t i = 0; i < WordCount; ++i)
+    {
+      m_words[i].store(words[i], std::memory_order_relaxed);
+    }
+  }
+
+  template <typename ValueType>
+  ValueType SeqLockItem<ValueType>::to_value(const Words& words) noexcept
+  {
+    static_assert(std::is_trivially_copyable<ValueType>::value, "Only trivially copyable values may be copied as bytes!");
+    static_assert(sizeof(Words) >= sizeof(ValueType), "Words must hold the whole value!");
+
+    // the value is trivially copyable, but may have a default constructor, which -Wclass-memaccess objects to
+    ValueType value;
+    std::memcpy(static_cast<void*>(&value), words.data(), sizeof(ValueType));
+
+    return value;
+  }
+
+  template <typename ValueType>
+  typename SeqLockItem<ValueType>::Words SeqLockItem<ValueType>::from_value(const ValueType& value) noexcept
+  {
+    static_assert(std::is_trivially_copyable<ValueType>::value, "Only trivially copyable values may be copied as bytes!");
+    static_assert(sizeof(Words) >= sizeof(ValueType), "Words must hold the whole value!");
+
+    Words words = {};
+    std::memcpy(words.data(), &value, sizeof(ValueType));
+
+    return words;
+  }
+
+}
@@ -1,22 +1,39 @@
 #pragma once
 
+#include <cache/fixed_string.h>
 #include <cache/item.h>
+#include <cache/item_options.h>
 
 #include <type_traits>
 
 namespace cache
 {
 
+  /**
+   * \class PrefersSeqLock
+   * \brief Checks if read-heavy items of a trivially copyable ValueType without lock-free atomic operations are
+   * held in SeqLockItems rather than LockBasedItems
+   * \details True for inline values (see BasicFixedString), which are cheap to copy; may be specialized for
+   * other trivially copyable types
+   */
+  template <typename ValueType>
+  struct PrefersSeqLock : std::false_type
+  {
+  };
+
+  template <size_t Capacity, typename CharType>
+  struct PrefersSeqLock<BasicFixedString<Capacity, CharType>> : std::true_type
+  {
+  };
+
   /**
    * \brief Creates an item
    * \details This implementation is only enabled for trivially copyable types so std::atomic can be
    * instantiated for ValueType. LockFreeItem will be created if atomic operations are implemented
-   * for ValueType. Otherwise, LockBasedItem will be created
+   * for ValueType. Otherwise, RcuItem, SeqLockItem (if read-heavy and PrefersSeqLock) or LockBasedItem will be created
    * \tparam ValueType - type of the item
    * \param value - initial value of the item
-   * \param writeHeavy - if true, standard mutexes and unique locks will be used (better for write-heavy modifications)
-   * if false, shared mutexes and read-write locks will be used (better for read-heavy modifications)
-   * has no effect in case LockFreeItem is created
+   * \param options - implementation of the item, which has no effect in case LockFreeItem is created
    */
   template <
     typename ValueType, 
@@ -28,18 +45,16 @@ namespace cache
       >::value
     >* = nullptr
   >
-  std::unique_ptr<Item<std::decay_t<ValueType>>> make_item(const ValueType& value, bool writeHeavy = false);
+  std::unique_ptr<Item<std::decay_t<ValueType>>> make_item(const ValueType& value, const ItemOptions& options = ItemOptions());
 
   /**
    * \brief Creates an item
    * \details This implementation is only enabled for trivially copyable types so std::atomic can be
    * instantiated for ValueType. LockFreeItem will be created if atomic operations are implemented
-   * for ValueType. Otherwise, LockBasedItem will be created
+   * for ValueType. Otherwise, RcuItem, SeqLockItem (if read-heavy and PrefersSeqLock) or LockBasedItem will be created
    * \tparam ValueType - type of the item
    * \param value - initial value of the item
-   * \param writeHeavy - if true, standard mutexes and unique locks will be used (better for write-heavy modifications)
-   * if false, shared mutexes and read-write locks will be used (better for read-heavy modifications)
-   * has no effect in case LockFreeItem is created
+   * \param options - implementation of the item, which has no effect in case LockFreeItem is created
    */
   template <
     typename ValueType, 
@@ -51,16 +66,15 @@ namespace cache
       >::value
     >* = nullptr
   >
-  std::unique_ptr<Item<std::decay_t<ValueType>>> make_item(ValueType&& value, bool writeHeavy = false);
+  std::unique_ptr<Item<std::decay_t<ValueType>>> make_item(ValueType&& value, const ItemOptions& options = ItemOptions());
 
   /**
    * \brief Creates an item
    * \details This implementation is only enabled for non-trivially copyable types so std::atomic cannot be
-   * instantiated for ValueType. LockBasedItem will be created
+   * instantiated for ValueType. RcuItem or LockBasedItem will be created
    * \tparam ValueType - type of the item
    * \param value - initial value of the item
-   * \param writeHeavy - if true, standard mutexes and unique locks will be used (better for write-heavy modifications)
-   * if false, shared mutexes and read-write locks will be used (better for read-heavy modifications)
+   * \param options - implementation of the item
    */
   template <
     typename ValueType, 
@@ -72,16 +86,15 @@ namespace cache
       >::value
     >* = nullptr
   >
-  std::unique_ptr<Item<std::decay_t<ValueType>>> make_item(const ValueType& value, bool writeHeavy = false);
+  std::unique_ptr<Item<std::decay_t<ValueType>>> make_item(const ValueType& value, const ItemOptions& options = ItemOptions());
 
   /**
    * \brief Creates an item
    * \details This implementation is only enabled for non-trivially copyable types so std::atomic cannot be
-   * instantiated for ValueType. LockBasedItem will be created
+   * instantiated for ValueType. RcuItem or LockBasedItem will be created
    * \tparam ValueType - type of the item
    * \param value - initial value of the item
-   * \param writeHeavy - if true, standard mutexes and unique locks will be used (better for write-heavy modifications)
-   * if false, shared mutexes and read-write locks will be used (better for read-heavy modifications)
+   * \param options - implementation of the item
    */
   template <
     typename ValueType, 
@@ -93,7 +106,7 @@ namespace cache
       >::value
     >* = nullptr
   >
-  std::unique_ptr<Item<std::decay_t<ValueType>>> make_item(ValueType&& value, bool writeHeavy = false);
+  std::unique_ptr<Item<std::decay_t<ValueType>>> make_item(ValueType&& value, const ItemOptions& options = ItemOptions());
 
 }
 
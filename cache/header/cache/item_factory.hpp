@@ -2,48 +2,85 @@
 
 #include <cache/item/lock_based_item.h>
 #include <cache/item/lock_free_item.h>
+#include <cache/item/rcu_item.h>
+#include <cache/item/seq_lock_item.h>
 
 #include <atomic>
 
 namespace cache
 {
 
+  template <typename ValueType, typename ValueTypeFwd>
+  std::unique_ptr<Item<ValueType>> make_locked_item(ValueTypeFwd&& value, const ItemOptions& options, std::true_type)
+  {
+    if (options.writeHeavy)
+    {
+      return std::make_unique<LockBasedItem<ValueType>>(std::forward<ValueTypeFwd>(value), options.writeHeavy);
+    }
+
+    return std::make_unique<SeqLockItem<ValueType>>(std::forward<ValueTypeFwd>(value));
+  }
+
+  template <typename ValueType, typename ValueTypeFwd>
+  std::unique_ptr<Item<ValueType>> make_locked_item(ValueTypeFwd&& value, const ItemOptions& options, std::false_type)
+  {
+    return std::make_unique<LockBasedItem<ValueType>>(std::forward<ValueTypeFwd>(value), options.writeHeavy);
+  }
+
   template <typename ValueType, typename std::enable_if_t<std::is_trivially_copyable<std::decay_t<ValueType>>::value>*>
-  std::unique_ptr<Item<std::decay_t<ValueType>>> make_item(const ValueType& value, bool writeHeavy)
+  std::unique_ptr<Item<std::decay_t<ValueType>>> make_item(const ValueType& value, const ItemOptions& options)
   {
     if (std::atomic<std::decay_t<ValueType>>().is_lock_free())
     {
       return std::make_unique<LockFreeItem<std::decay_t<ValueType>>>(value);
     }
+    else if (options.rcu)
+    {
+      return std::make_unique<RcuItem<std::decay_t<ValueType>>>(value);
+    }
     else
     {
-      return std::make_unique<LockBasedItem<std::decay_t<ValueType>>>(value, writeHeavy);
+      return make_locked_item<std::decay_t<ValueType>>(value, options, PrefersSeqLock<std::decay_t<ValueType>>());
     }
   }
 
   template <typename ValueType, typename std::enable_if_t<std::is_trivially_copyable<std::decay_t<ValueType>>::value>*>
-  std::unique_ptr<Item<std::decay_t<ValueType>>> make_item(ValueType&& value, bool writeHeavy)
+  std::unique_ptr<Item<std::decay_t<ValueType>>> make_item(ValueType&& value, const ItemOptions& options)
   {
     if (std::atomic<std::decay_t<ValueType>>().is_lock_free())
     {
       return std::make_unique<LockFreeItem<std::decay_t<ValueType>>>(std::move(value));
     }
+    else if (options.rcu)
+    {
+      return std::make_unique<RcuItem<std::decay_t<ValueType>>>(std::move(value));
+    }
     else
     {
-      return std::make_unique<LockBasedItem<std::decay_t<ValueType>>>(std::move(value), writeHeavy);
+      return make_locked_item<std::decay_t<ValueType>>(std::move(value), options, PrefersSeqLock<std::decay_t<ValueType>>());
     }
   }
 
   template <typename ValueType, typename std::enable_if_t<!std::is_trivially_copyable<std::decay_t<ValueType>>::value>*>
-  std::unique_ptr<Item<std::decay_t<ValueType>>> make_item(const ValueType& value, bool writeHeavy)
+  std::unique_ptr<Item<std::decay_t<ValueType>>> make_item(const ValueType& value, const ItemOptions& options)
   {
-    return std::make_unique<LockBasedItem<std::decay_t<ValueType>>>(value, writeHeavy);
+    if (options.rcu)
+    {
+      return std::make_unique<RcuItem<std::decay_t<ValueType>>>(value);
+    }
+
+    return std::make_unique<LockBasedItem<std::decay_t<ValueType>>>(value, options.writeHeavy);
   }
 
   template <typename ValueType, typename std::enable_if_t<!std::is_trivially_copyable<std::decay_t<ValueType>>::value>*>
-  std::unique_ptr<Item<std::decay_t<ValueType>>> make_item(ValueType&& value, bool writeHeavy)
+  std::unique_ptr<Item<std::decay_t<ValueType>>> make_item(ValueType&& value, const ItemOptions& options)
   {
-    return std::make_unique<LockBasedItem<std::decay_t<ValueType>>>(std::move(value), writeHeavy);
+    if (options.rcu)
+    {
+      return std::make_unique<RcuItem<std::decay_t<ValueType>>>(std::move(value));
+    }
+
+    return std::make_unique<LockBasedItem<std::decay_t<ValueType>>>(std::move(value), options.writeHeavy);
   }
 
 }
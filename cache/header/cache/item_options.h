@@ -0,0 +1,24 @@
+#pragma once
+
+namespace cache
+{
+
+  /**
+   * \class ItemOptions
+   * \brief Options selecting the implementation of the items of a Cache (see make_item)
+   * \details Implicitly constructible from the writeHeavy flag, which used to be the only option
+   */
+  struct ItemOptions
+  {
+    ItemOptions(bool writeHeavy = false) noexcept
+      : writeHeavy(writeHeavy)
+    {
+    }
+
+    bool writeHeavy;  ///< if true, standard mutexes and unique locks will be used (better for write-heavy modifications)
+                      ///< if false, shared mutexes and read-write locks will be used (better for read-heavy modifications),
+                      ///< except for inline values (see PrefersSeqLock), which are held in SeqLockItems
+    bool rcu = false; ///< if true, values without lock-free atomic operations are held in RcuItems, read without locking
+  };
+
+}
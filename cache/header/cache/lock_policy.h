@@ -1,5 +1,7 @@
 #pragma once
 
+#include <utility/lock_profile.h>
+
 #include <memory>
 
 namespace cache
@@ -55,6 +57,13 @@ namespace cache
    * \brief Creates a LockPolicy
    * \param writeHeavy - if true, standard mutexes and unique locks will be used (better for write-heavy modifications)
    * if false, shared mutexes and true read-write locks will be used (better for read-heavy modifications)
+   * \param profile - LockProfile to record into if lock profiling is enabled
+   */
+  std::unique_ptr<LockPolicy> make_lock_policy(bool writeHeavy, utility::LockProfileRef profile);
+
+  /**
+   * \brief Creates a LockPolicy recording into the "item" LockProfile
+   * \param writeHeavy - see above
    */
   std::unique_ptr<LockPolicy> make_lock_policy(bool writeHeavy);
 
@@ -1,10 +1,19 @@
 #include <cache/lock_policy.h>
 
+#include <utility/lock_profile.h>
 #include <utility/shared_mutex_adaptor.h>
 
+#include <mutex>
+
 namespace cache
 {
 
+  /**
+   * \class ReadHeavyMutex
+   * \brief Shared mutex used by ReadHeavyLockPolicy
+   */
+  using ReadHeavyMutex = utility::ProfiledMutex<utility::SharedMutex>;
+
   /**
    * \class ReadHeavyUniqueLock
    * \brief Interface to a unique lock constructed from a shared mutex
@@ -16,10 +25,10 @@ namespace cache
      * \class Constructor
      * \param mutex - mutex to create a lock on
      */
-    explicit ReadHeavyUniqueLock(utility::SharedMutex& mutex);
+    explicit ReadHeavyUniqueLock(ReadHeavyMutex& mutex);
 
   private:
-    const std::unique_lock<utility::SharedMutex> m_lock;
+    const std::unique_lock<ReadHeavyMutex> m_lock;
   };
 
   /**
@@ -33,10 +42,10 @@ namespace cache
      * \class Constructor
      * \param mutex - mutex to create a lock on
      */
-    explicit ReadHeavySharedLock(utility::SharedMutex& mutex);
+    explicit ReadHeavySharedLock(ReadHeavyMutex& mutex);
 
   private:
-    const std::shared_lock<utility::SharedMutex> m_lock;
+    const std::shared_lock<ReadHeavyMutex> m_lock;
   };
 
   /**
@@ -47,6 +56,12 @@ namespace cache
   class ReadHeavyLockPolicy : public LockPolicy
   {
   public:
+    /**
+     * \brief Constructor
+     * \param profile - LockProfile to record into if lock profiling is enabled
+     */
+    explicit ReadHeavyLockPolicy(utility::LockProfileRef profile);
+
     /**
      * \brief Creates a UniqueLock on the internal mutex
      */
@@ -58,7 +73,7 @@ namespace cache
     virtual std::unique_ptr<SharedLock> acquire_shared_lock() override final;
 
   private:
-    utility::SharedMutex m_mutex;
+    ReadHeavyMutex m_mutex;
   }; 
   
 }
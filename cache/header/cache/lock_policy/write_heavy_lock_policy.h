@@ -1,10 +1,18 @@
 #include <cache/lock_policy.h>
 
+#include <utility/lock_profile.h>
+
 #include <mutex>
 
 namespace cache
 {
 
+  /**
+   * \class WriteHeavyMutex
+   * \brief Standard mutex used by WriteHeavyLockPolicy
+   */
+  using WriteHeavyMutex = utility::ProfiledMutex<std::mutex>;
+
   /**
    * \class WriteHeavyUniqueLock
    * \brief Interface to a unique lock constructed from a standard mutex
@@ -16,10 +24,10 @@ namespace cache
      * \class Constructor
      * \param mutex - mutex to create a lock on
      */
-    explicit WriteHeavyUniqueLock(std::mutex& mutex);
+    explicit WriteHeavyUniqueLock(WriteHeavyMutex& mutex);
 
   private:
-    const std::lock_guard<std::mutex> m_lock;
+    const std::lock_guard<WriteHeavyMutex> m_lock;
   };
 
   /**
@@ -33,10 +41,10 @@ namespace cache
      * \class Constructor
      * \param mutex - mutex to create a lock on
      */
-    explicit WriteHeavySharedLock(std::mutex& mutex);
+    explicit WriteHeavySharedLock(WriteHeavyMutex& mutex);
 
   private:
-    const std::lock_guard<std::mutex> m_lock;
+    const std::lock_guard<WriteHeavyMutex> m_lock;
   };
 
   /**
@@ -47,6 +55,12 @@ namespace cache
   class WriteHeavyLockPolicy : public LockPolicy
   {
   public:
+    /**
+     * \brief Constructor
+     * \param profile - LockProfile to record into if lock profiling is enabled
+     */
+    explicit WriteHeavyLockPolicy(utility::LockProfileRef profile);
+
     /**
      * \brief Creates a UniqueLock on the internal mutex
      */
@@ -58,7 +72,7 @@ namespace cache
     virtual std::unique_ptr<SharedLock> acquire_shared_lock() override final;
 
   private:
-    std::mutex m_mutex;
+    WriteHeavyMutex m_mutex;
   }; 
   
 }
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <utility/periodic_task.h>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace cache
+{
+
+  /**
+   * \class MemoryGuard
+   * \brief Keeps memory usage within a budget by resizing a cache in the background
+   * \details Once memory usage exceeds the high-water mark, the cache is shrunk in proportion, so that usage falls
+   * to the low-water mark (see Cache::resize). Freed memory is not necessarily returned to the system (e.g. resident
+   * memory of the process), so the guard does not shrink the cache again until usage grows beyond the one observed
+   * at the last shrink, and then only in proportion to that growth. While usage stays below the low-water mark,
+   * the size of the cache is gradually grown back, up to its size at construction of the guard.
+   * The guard must be destroyed before the cache
+   * \tparam CacheType - type of the guarded cache
+   */
+  template <typename CacheType>
+  class MemoryGuard
+  {
+  public:
+    /**
+     * \class Usage
+     * \brief Function object returning the current memory usage in bytes
+     * \details E.g. Cache::memory_usage for memory accounted by the cache, or utility::resident_memory
+     * for the resident memory of the process
+     */
+    using Usage = std::function<size_t()>;
+
+  public:
+    /**
+     * \brief Constructor
+     * \param cache - cache to resize
+     * \param usage - function object returning the memory usage to keep within the budget
+     * \param highWaterMark - memory usage (in bytes) triggering the shrink of the cache
+     * \param lowWaterMark - memory usage (in bytes) the cache is shrunk down to
+     * \param interval - time between memory usage checks
+     * \param minSize - size (in objects) below which the cache is not shrunk, raised to the number of its shards
+     * \throw if lowWaterMark is 0 or exceeds highWaterMark, minSize is 0, or interval is not positive
+     */
+    MemoryGuard(
+      CacheType& cache, 
+      const Usage& usage, 
+      size_t highWaterMark, 
+      size_t lowWaterMark, 
+      std::chrono::milliseconds interval,
+      size_t minSize = 1
+    );
+
+    MemoryGuard(const MemoryGuard&) = delete;
+    MemoryGuard& operator=(const MemoryGuard&) = delete;
+
+    /**
+     * \brief Checks memory usage and resizes the cache if needed
+     * \details Executed periodically in the background; may be called directly to react at once
+     * \return new size of the cache
+     */
+    size_t check();
+
+  private:
+    CacheType& m_cache;
+    const Usage m_usage;
+    const size_t m_highWaterMark;
+    const size_t m_lowWaterMark;
+    const size_t m_minSize;
+    const size_t m_maxSize;
+    size_t m_shrinkUsage; ///< usage at the last shrink, or 0 once usage is back within the high-water mark
+    std::mutex m_mutex;
+    std::unique_ptr<utility::PeriodicTask> m_task;
+  };
+
+}
+
+#include <cache/memory_guard.hpp>
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <utility/exceptions.h>
+
+#include <algorithm>
+
+namespace cache
+{
+
+  template <typename CacheType>
+  MemoryGuard<CacheType>::MemoryGuard(
+    CacheType& cache, 
+    const Usage& usage, 
+    size_t highWaterMark, 
+    size_t lowWaterMark, 
+    std::chrono::milliseconds interval,
+    size_t minSize
+  ) try
+    : m_cache(cache)
+    , m_usage(usage)
+    , m_highWaterMark(highWaterMark)
+    , m_lowWaterMark(lowWaterMark)
+    , m_minSize(std::max(minSize, cache.shard_count()))
+    , m_maxSize(cache.stats().capacity)
+    , m_shrinkUsage(0)
+  {
+    THROW_IF(m_lowWaterMark == 0, "Low-water mark is 0!");
+    THROW_IF(m_lowWaterMark > m_highWaterMark, "Low-water mark = ", m_lowWaterMark, " exceeds high-water mark = ", m_highWaterMark);
+    THROW_IF(minSize == 0, "Minimal size is 0!");
+
+    m_task = std::make_unique<utility::PeriodicTask>(interval, [this] { check(); });
+  }
+  catch (...)
+  {
+    RETHROW("Failed to construct a MemoryGuard!");
+  }
+
+  template <typename CacheType>
+  size_t MemoryGuard<CacheType>::check() try
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto usage = m_usage();
+    auto size = m_cache.stats().capacity;
+    auto newSize = size;
+
+    if (usage > m_highWaterMark)
+    {
+      // usage may stay high after a shrink, so only its growth since then is accounted for
+      if (m_shrinkUsage == 0 || usage > m_shrinkUsage)
+      {
+        auto target = m_shrinkUsage == 0 ? m_lowWaterMark : m_shrinkUsage;
+
+        newSize = static_cast<size_t>(static_cast<double>(size) * target / usage);
+        newSize = std::max(newSize, m_minSize);
+        m_shrinkUsage = usage;
+      }
+    }
+    else
+    {
+      m_shrinkUsage = 0;
+
+      if (usage < m_lowWaterMark && size < m_maxSize)
+      {
+        // growth is capped at 1/8 per check, since usage may only catch up with the size of the cache over time
+        auto fitting = usage == 0 ? m_maxSize : static_cast<size_t>(static_cast<double>(size) * m_lowWaterMark / usage);
+        newSize = std::min({ fitting, size + size / 8 + 1, m_maxSize });
+        newSize = std::max(newSize, size);
+      }
+    }
+
+    if (newSize != size)
+    {
+      m_cache.resize(newSize);
+    }
+
+    return newSize;
+  }
+  catch (...)
+  {
+    RETHROW("Failed to check memory usage!");
+  }
+
+}
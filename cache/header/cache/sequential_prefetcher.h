@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <type_traits>
+
+namespace cache
+{
+
+  /**
+   * \class SequentialPrefetcher
+   * \brief Detects runs of ascending consecutive keys in a stream of lookups and prefetches the keys ahead of them
+   * \details Once runLength consecutive keys have been accessed, the next distance keys are passed to the prefetch
+   * function object, executed asynchronously (e.g. loading them with a single pass over a file and inserting them
+   * into a cache, see Cache::insert). While the run continues, the next keys are prefetched again as soon as no more
+   * than distance / 2 prefetched keys remain ahead, so the prefetched range stays ahead of the stream.
+   * At most one prefetch is in flight; accesses made meanwhile do not wait for it.
+   * Not threadsafe: each stream (e.g. reader thread) should own its prefetcher
+   * \tparam KeyType - integral type of keys
+   */
+  template <typename KeyType>
+  class SequentialPrefetcher
+  {
+    static_assert(std::is_integral<KeyType>::value, "Sequential prefetch requires integral keys!");
+
+  public:
+    /**
+     * \class Prefetch
+     * \brief Function object taking the first key and the number of keys to prefetch
+     */
+    using Prefetch = std::function<void(KeyType, size_t)>;
+
+  public:
+    /**
+     * \brief Constructor
+     * \param prefetch - function object prefetching a range of keys, executed on a separate thread
+     * \param distance - number of keys prefetched ahead of the stream
+     * \param runLength - number of consecutive keys detected as a sequential run
+     * \throw if distance or runLength is 0
+     */
+    SequentialPrefetcher(const Prefetch& prefetch, size_t distance = 256, size_t runLength = 4);
+
+    SequentialPrefetcher(const SequentialPrefetcher&) = delete;
+    SequentialPrefetcher& operator=(const SequentialPrefetcher&) = delete;
+
+    /**
+     * \brief Waits for the prefetch in flight, if any, ignoring its exceptions
+     */
+    ~SequentialPrefetcher();
+
+    /**
+     * \brief Records an access to a key, starting a prefetch if the key continues a sequential run
+     * \throw if the previous prefetch has thrown
+     */
+    void access(KeyType key);
+
+    /**
+     * \brief Waits for the prefetch in flight, if any
+     * \throw if the prefetch has thrown
+     */
+    void wait();
+
+    /**
+     * \brief Returns the number of started prefetches
+     */
+    size_t prefetches() const noexcept;
+
+  private:
+    const Prefetch m_prefetch;
+    const size_t m_distance;
+    const size_t m_runLength;
+    KeyType m_last;
+    size_t m_run;
+    KeyType m_prefetchedEnd;
+    size_t m_prefetches;
+    std::future<void> m_inFlight;
+  };
+
+}
+
+#include <cache/sequential_prefetcher.hpp>
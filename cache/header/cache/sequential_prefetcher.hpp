@@ -0,0 +1,108 @@
+#pragma once
+
+#include <utility/exceptions.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace cache
+{
+
+  template <typename KeyType>
+  SequentialPrefetcher<KeyType>::SequentialPrefetcher(const Prefetch& prefetch, size_t distance, size_t runLength) try
+    : m_prefetch(prefetch)
+    , m_distance(distance)
+    , m_runLength(runLength)
+    , m_last()
+    , m_run(0)
+    , m_prefetchedEnd()
+    , m_prefetches(0)
+  {
+    THROW_IF(!m_prefetch, "Prefetch function is empty!");
+    THROW_IF(m_distance == 0, "Prefetch distance is 0!");
+    THROW_IF(m_runLength == 0, "Run length is 0!");
+  }
+  catch (...)
+  {
+    RETHROW("Failed to construct a SequentialPrefetcher with distance = ", distance, " and run length = ", runLength);
+  }
+
+  template <typename KeyType>
+  SequentialPrefetcher<KeyType>::~SequentialPrefetcher()
+  {
+    try
+    {
+      wait();
+    }
+    catch (...)
+    {
+    }
+  }
+
+  template <typename KeyType>
+  void SequentialPrefetcher<KeyType>::access(KeyType key) try
+  {
+    if (m_run != 0 && key == static_cast<KeyType>(m_last + 1))
+    {
+      ++m_run;
+    }
+    else
+    {
+      m_run = 1;
+      m_prefetchedEnd = key;
+    }
+
+    m_last = key;
+
+    if (m_run < m_runLength)
+    {
+      return;
+    }
+
+    auto next = static_cast<KeyType>(key + 1);
+    auto ahead = m_prefetchedEnd > next ? static_cast<size_t>(m_prefetchedEnd - next) : 0;
+
+    if (ahead > m_distance / 2 || next < key)
+    {
+      return;
+    }
+
+    if (m_inFlight.valid())
+    {
+      if (m_inFlight.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      {
+        return;
+      }
+
+      m_inFlight.get();
+    }
+
+    auto first = std::max(next, m_prefetchedEnd);
+    auto count = m_distance - ahead;
+
+    m_prefetchedEnd = static_cast<KeyType>(first + count);
+    m_inFlight = std::async(std::launch::async, m_prefetch, first, count);
+
+    ++m_prefetches;
+  }
+  catch (...)
+  {
+    RETHROW("Failed to prefetch after key = ", key);
+  }
+
+  template <typename KeyType>
+  void SequentialPrefetcher<KeyType>::wait()
+  {
+    if (m_inFlight.valid())
+    {
+      m_inFlight.get();
+    }
+  }
+
+  template <typename KeyType>
+  size_t SequentialPrefetcher<KeyType>::prefetches() const noexcept
+  {
+    return m_prefetches;
+  }
+
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+
+namespace cache
+{
+
+  /**
+   * \class ShardingOptions
+   * \brief Options splitting a Cache into independently locked shards
+   * \details Each key belongs to a single shard, chosen by its hash. Shards are least-recently used caches of
+   * their own, each holding an even share of the size of the cache, so recency is only ordered within a shard
+   */
+  struct ShardingOptions
+  {
+    size_t shardCount = 1;  ///< number of shards
+    bool numaAware = false; ///< if true, shards are spread over NUMA nodes, their index, recency queue and entries
+                            ///< being allocated on their node; has no effect on machines with a single NUMA node
+  };
+
+}
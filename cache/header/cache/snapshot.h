@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace cache
+{
+
+  /**
+   * \class SnapshotCodec
+   * \brief Encodes keys and values of a given type in cache snapshots (see Cache::save)
+   * \details Implemented for trivially copyable types, stored as raw bytes, and std::string, stored as its length
+   * followed by its characters. Specialize it to save caches with keys or values of other types; specializations
+   * also declare MinSize, the smallest number of bytes an encoded object takes.
+   * Snapshots are only meant to be restored on the platform they were saved on
+   * \tparam ValueType - type of encoded objects
+   */
+  template <typename ValueType, typename Enable = void>
+  struct SnapshotCodec;
+
+  template <typename ValueType>
+  struct SnapshotCodec<ValueType, std::enable_if_t<std::is_trivially_copyable<ValueType>::value>>
+  {
+    static constexpr size_t MinSize = sizeof(ValueType);  ///< size of every encoded value
+
+    /**
+     * \brief Writes an encoded value to a stream
+     */
+    static void write(std::ostream& out, const ValueType& value);
+
+    /**
+     * \brief Decodes a value from a buffer
+     * \param data - pointer to the first byte of the encoded value
+     * \param end - pointer past the last byte of the buffer
+     * \return pointer past the last byte of the encoded value
+     * \throw if the buffer ends before the value does
+     */
+    static const char* read(const char* data, const char* end, ValueType& value);
+  };
+
+  template <>
+  struct SnapshotCodec<std::string>
+  {
+    static constexpr size_t MinSize = sizeof(uint64_t);  ///< size of an encoded empty string
+
+    /**
+     * \brief Writes an encoded string to a stream
+     */
+    static void write(std::ostream& out, const std::string& value);
+
+    /**
+     * \brief Decodes a string from a buffer
+     * \param data - pointer to the first byte of the encoded string
+     * \param end - pointer past the last byte of the buffer
+     * \return pointer past the last byte of the encoded string
+     * \throw if the buffer ends before the string does
+     */
+    static const char* read(const char* data, const char* end, std::string& value);
+  };
+
+  /**
+   * \brief Writes the header of a snapshot holding a given number of items
+   */
+  void write_snapshot_header(std::ostream& out, uint64_t count);
+
+  /**
+   * \brief Checks the header of a snapshot and reads the number of items it holds
+   * \return pointer past the last byte of the header
+   * \throw if the buffer does not start with a valid snapshot header
+   */
+  const char* read_snapshot_header(const char* data, const char* end, uint64_t& count);
+
+  /**
+   * \brief Flag marking items saved as dirty in a snapshot
+   */
+  constexpr uint8_t SnapshotDirtyFlag = 1;
+
+}
+
+#include <cache/snapshot.hpp>
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <utility/exceptions.h>
+
+#include <cstring>
+
+namespace cache
+{
+
+  template <typename ValueType>
+  void SnapshotCodec<ValueType, std::enable_if_t<std::is_trivially_copyable<ValueType>::value>>::write(
+    std::ostream& out, 
+    const ValueType& value
+  )
+  {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  template <typename ValueType>
+  const char* SnapshotCodec<ValueType, std::enable_if_t<std::is_trivially_copyable<ValueType>::value>>::read(
+    const char* data, 
+    const char* end, 
+    ValueType& value
+  )
+  {
+    THROW_IF(static_cast<size_t>(end - data) < sizeof(value), "Snapshot ends within a value of size = ", sizeof(value));
+
+    std::memcpy(&value, data, sizeof(value));
+
+    return data + sizeof(value);
+  }
+
+}
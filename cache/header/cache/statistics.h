@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace cache
+{
+
+  /**
+   * \class Statistics
+   * \brief Snapshot of cache usage counters
+   * \details Counters are accumulated since construction of the cache. hookInvocations approximates the writes
+   * reaching the update hook: evicted and erased items are counted if dirty when they leave the cache, before
+   * the hook runs on their release. So an item flushed concurrently with its removal is counted twice, while
+   * hook runs for items written through pointers kept after their removal, or released with the cache
+   * (UpdateReason::Destroyed), are not counted
+   */
+  struct Statistics
+  {
+    uint64_t hits;            ///< lookups of items found in the cache
+    uint64_t misses;          ///< lookups which created a new item
+    uint64_t evictions;       ///< items removed from the cache in favour of more recently used ones
+    uint64_t hookInvocations; ///< dirty items removed by evictions and erasures or flushed, see above
+    uint64_t absentHits;      ///< lookups answered by a known absence of the key
+    size_t queueSize;         ///< number of items in the recency queue
+    size_t mapSize;           ///< number of items in the index
+    size_t capacity;          ///< maximum number of items
+    size_t absentSize;        ///< number of keys known to be absent
+    size_t retiredSize;       ///< number of items removed from the cache and awaiting epoch-based reclamation
+
+    /**
+     * \brief Returns the share of lookups which found the item in the cache, or 0 if there were no lookups
+     */
+    double hit_ratio() const noexcept;
+  };
+
+}
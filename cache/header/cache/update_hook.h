@@ -1,14 +1,28 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <type_traits>
 
 namespace cache
 {
 
+  /**
+   * \enum UpdateReason
+   * \brief Reason for which an UpdateHook is executed on an item
+   */
+  enum class UpdateReason
+  {
+    Evicted,   ///< the item was removed from the cache in favour of a more recently used one
+    Destroyed, ///< the cache was destroyed while holding the item
+    Flushed,   ///< the item was flushed by Cache::flush and remains in the cache
+    Erased     ///< the item was removed by Cache::erase, erase_if or clear
+  };
+
   /**
    * \class UpdateHook
-   * \brief Adaptor for a noexcept function object with two arguments
-   * \details Used for file updates upon destruction of cache items
+   * \brief Adaptor for a noexcept function object with two or three arguments
+   * \details Used for file updates upon destruction of modified (dirty) cache items
    * \tparam KeyType - type of keys in Cache
    * \tparam ValueType - type of values in Cache
    */
@@ -16,12 +30,13 @@ namespace cache
   class UpdateHook
   {
   private:
-    using Impl = std::function<void(const KeyType&, const ValueType&)>;
+    using Impl = std::function<void(const KeyType&, const ValueType&, UpdateReason)>;
 
   public:
     /**
      * \brief Conversion constructor
-     * \param func - noexcept function object with void return type taking KeyType and ValueType as arguments
+     * \param func - noexcept function object with void return type taking KeyType, ValueType and, optionally,
+     * UpdateReason as arguments
      * \details Since noexcept is not part of function type before C++17, raw function pointers and its
      * users (e.g. std::function) cannot be used as func. Only noexcept explicit noexcept functors and
      * closures can be used in C++14 and before. Move constructor overloading is disabled.
@@ -42,8 +57,16 @@ namespace cache
 
     /**
      * \brief Passes the arguments to the function object forwarded in constructor
+     * \details reason is dropped if the function object only takes a key and a value
      */
-    void operator()(const KeyType& key, const ValueType& value) const noexcept;
+    void operator()(const KeyType& key, const ValueType& value, UpdateReason reason = UpdateReason::Evicted) const noexcept;
+
+  private:
+    template <typename FuncFwd>
+    static Impl adapt(FuncFwd&& func, std::true_type);
+
+    template <typename FuncFwd>
+    static Impl adapt(FuncFwd&& func, std::false_type);
 
   private:
     Impl m_impl;
@@ -52,6 +75,58 @@ namespace cache
   template <typename KeyType, typename ValueType, typename FuncFwd>
   UpdateHook<KeyType, ValueType> make_update_hook(FuncFwd&& func);
 
+  /**
+   * \brief Executes an update hook
+   * \details reason is dropped in case func only takes a key and a value
+   * \param func - noexcept function object with void return type taking KeyType, ValueType and, optionally,
+   * UpdateReason as arguments
+   */
+  template <typename Func, typename KeyType, typename ValueType>
+  void invoke_update_hook(const Func& func, const KeyType& key, const ValueType& value, UpdateReason reason) noexcept;
+
+  /**
+   * \class UpdateHookRef
+   * \brief Per-item reference to an update hook shared by all items of a cache
+   * \details Stateless (empty) hooks are copied and take no space when used as a base class (empty base
+   * optimization). Stateful hooks are shared, so the lifetime of the hook is extended by the items
+   * outliving the cache, and no copy or allocation is made per item
+   * \tparam Func - type of the update hook
+   */
+  template <typename Func, bool Stateless = std::is_empty<Func>::value && !std::is_final<Func>::value>
+  class UpdateHookRef : private Func
+  {
+  public:
+    /**
+     * \brief Constructor
+     * \param func - hook shared by the cache
+     */
+    explicit UpdateHookRef(const std::shared_ptr<const Func>& func);
+
+    /**
+     * \brief Returns the referenced hook
+     */
+    const Func& update_hook() const noexcept;
+  };
+
+  template <typename Func>
+  class UpdateHookRef<Func, false>
+  {
+  public:
+    /**
+     * \brief Constructor
+     * \param func - hook shared by the cache
+     */
+    explicit UpdateHookRef(const std::shared_ptr<const Func>& func);
+
+    /**
+     * \brief Returns the referenced hook
+     */
+    const Func& update_hook() const noexcept;
+
+  private:
+    std::shared_ptr<const Func> m_func;
+  };
+
 }
 
 #include <cache/update_hook.hpp>
@@ -3,6 +3,28 @@
 namespace cache
 {
 
+  /**
+   * \class TakesUpdateReason
+   * \brief Checks if Func can be called with a key, a value, and an UpdateReason
+   */
+  template <typename Func, typename KeyType, typename ValueType, typename = void>
+  struct TakesUpdateReason : std::false_type
+  {
+  };
+
+  template <typename Func, typename KeyType, typename ValueType>
+  struct TakesUpdateReason<
+    Func, 
+    KeyType, 
+    ValueType, 
+    decltype(
+      std::declval<const Func&>()(std::declval<const KeyType&>(), std::declval<const ValueType&>(), UpdateReason::Evicted),
+      void()
+    )
+  > : std::true_type
+  {
+  };
+
   template <typename KeyType, typename ValueType>
   template <
     typename FuncFwd,
@@ -17,15 +39,35 @@ namespace cache
     >*
   >
   UpdateHook<KeyType, ValueType>::UpdateHook(FuncFwd&& func)
-    : m_impl(std::forward<FuncFwd>(func))
+    : m_impl(adapt(std::forward<FuncFwd>(func), TakesUpdateReason<std::decay_t<FuncFwd>, KeyType, ValueType>()))
   {
-    static_assert(noexcept(func(KeyType {}, ValueType {})), "Update hook must be a noexcept function!");
   }
 
   template <typename KeyType, typename ValueType>
-  void UpdateHook<KeyType, ValueType>::operator()(const KeyType& key, const ValueType& value) const noexcept
+  void UpdateHook<KeyType, ValueType>::operator()(const KeyType& key, const ValueType& value, UpdateReason reason) const noexcept
+  {
+    m_impl(key, value, reason);
+  }
+
+  template <typename KeyType, typename ValueType>
+  template <typename FuncFwd>
+  typename UpdateHook<KeyType, ValueType>::Impl UpdateHook<KeyType, ValueType>::adapt(FuncFwd&& func, std::true_type)
+  {
+    static_assert(noexcept(func(KeyType {}, ValueType {}, UpdateReason::Evicted)), "Update hook must be a noexcept function!");
+
+    return Impl(std::forward<FuncFwd>(func));
+  }
+
+  template <typename KeyType, typename ValueType>
+  template <typename FuncFwd>
+  typename UpdateHook<KeyType, ValueType>::Impl UpdateHook<KeyType, ValueType>::adapt(FuncFwd&& func, std::false_type)
   {
-    m_impl(key, value);
+    static_assert(noexcept(func(KeyType {}, ValueType {})), "Update hook must be a noexcept function!");
+
+    return [func = std::forward<FuncFwd>(func)] (const KeyType& key, const ValueType& value, UpdateReason)
+    {
+      func(key, value);
+    };
   }
 
   template <typename KeyType, typename ValueType, typename FuncFwd>
@@ -34,4 +76,50 @@ namespace cache
     return UpdateHook<KeyType, ValueType>(std::forward<FuncFwd>(func));
   }
 
+  template <typename Func, typename KeyType, typename ValueType>
+  void invoke_update_hook(const Func& func, const KeyType& key, const ValueType& value, UpdateReason reason, std::true_type) noexcept
+  {
+    static_assert(noexcept(func(key, value, reason)), "Update hook must be a noexcept function!");
+
+    func(key, value, reason);
+  }
+
+  template <typename Func, typename KeyType, typename ValueType>
+  void invoke_update_hook(const Func& func, const KeyType& key, const ValueType& value, UpdateReason, std::false_type) noexcept
+  {
+    static_assert(noexcept(func(key, value)), "Update hook must be a noexcept function!");
+
+    func(key, value);
+  }
+
+  template <typename Func, typename KeyType, typename ValueType>
+  void invoke_update_hook(const Func& func, const KeyType& key, const ValueType& value, UpdateReason reason) noexcept
+  {
+    invoke_update_hook(func, key, value, reason, TakesUpdateReason<Func, KeyType, ValueType>());
+  }
+
+  template <typename Func, bool Stateless>
+  UpdateHookRef<Func, Stateless>::UpdateHookRef(const std::shared_ptr<const Func>& func)
+    : Func(*func)
+  {
+  }
+
+  template <typename Func, bool Stateless>
+  const Func& UpdateHookRef<Func, Stateless>::update_hook() const noexcept
+  {
+    return *this;
+  }
+
+  template <typename Func>
+  UpdateHookRef<Func, false>::UpdateHookRef(const std::shared_ptr<const Func>& func)
+    : m_func(func)
+  {
+  }
+
+  template <typename Func>
+  const Func& UpdateHookRef<Func, false>::update_hook() const noexcept
+  {
+    return *m_func;
+  }
+
 }
@@ -5,11 +5,19 @@
 namespace cache
 {
 
-  std::unique_ptr<LockPolicy> make_lock_policy(bool writeHeavy)
+  std::unique_ptr<LockPolicy> make_lock_policy(bool writeHeavy, utility::LockProfileRef profile)
   {
     return writeHeavy
-         ? std::unique_ptr<LockPolicy>(new WriteHeavyLockPolicy())
-         : std::unique_ptr<LockPolicy>(new ReadHeavyLockPolicy());
+         ? std::unique_ptr<LockPolicy>(new WriteHeavyLockPolicy(profile))
+         : std::unique_ptr<LockPolicy>(new ReadHeavyLockPolicy(profile));
+  }
+
+  std::unique_ptr<LockPolicy> make_lock_policy(bool writeHeavy)
+  {
+    // looked up once, since items are created on every cache miss
+    static utility::LockProfileRef profile = utility::profiled_lock("item");
+
+    return make_lock_policy(writeHeavy, profile);
   }
 
 }
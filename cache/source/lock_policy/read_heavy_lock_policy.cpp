@@ -5,16 +5,21 @@
 namespace cache
 {
 
-  ReadHeavyUniqueLock::ReadHeavyUniqueLock(utility::SharedMutex& mutex)
+  ReadHeavyUniqueLock::ReadHeavyUniqueLock(ReadHeavyMutex& mutex)
     : m_lock(mutex)
   {
   }
 
-  ReadHeavySharedLock::ReadHeavySharedLock(utility::SharedMutex& mutex)
+  ReadHeavySharedLock::ReadHeavySharedLock(ReadHeavyMutex& mutex)
     : m_lock(mutex)
   {
   }
 
+  ReadHeavyLockPolicy::ReadHeavyLockPolicy(utility::LockProfileRef profile)
+    : m_mutex(profile)
+  {
+  }
+
   std::unique_ptr<UniqueLock> ReadHeavyLockPolicy::acquire_unique_lock()
   {
     return std::unique_ptr<UniqueLock>(new ReadHeavyUniqueLock(m_mutex));
@@ -3,16 +3,21 @@
 namespace cache
 {
 
-  WriteHeavyUniqueLock::WriteHeavyUniqueLock(std::mutex& mutex)
+  WriteHeavyUniqueLock::WriteHeavyUniqueLock(WriteHeavyMutex& mutex)
     : m_lock(mutex)
   {
   }
 
-  WriteHeavySharedLock::WriteHeavySharedLock(std::mutex& mutex)
+  WriteHeavySharedLock::WriteHeavySharedLock(WriteHeavyMutex& mutex)
     : m_lock(mutex)
   {
   }
 
+  WriteHeavyLockPolicy::WriteHeavyLockPolicy(utility::LockProfileRef profile)
+    : m_mutex(profile)
+  {
+  }
+
   std::unique_ptr<UniqueLock> WriteHeavyLockPolicy::acquire_unique_lock()
   {
     return std::unique_ptr<UniqueLock>(new WriteHeavyUniqueLock(m_mutex));
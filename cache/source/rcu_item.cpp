@@ -0,0 +1,21 @@
+#include <item/rcu_item.h>
+
+namespace cache
+{
+
+  utility::EpochDomain& rcu_domain()
+  {
+    // never destroyed, so items may be written until the process exits
+    static auto domain = new utility::EpochDomain();
+
+    return *domain;
+  }
+
+  utility::LockProfileRef rcu_lock_profile()
+  {
+    static utility::LockProfileRef profile = utility::profiled_lock("rcu item");
+
+    return profile;
+  }
+
+}
@@ -0,0 +1,53 @@
+#include <snapshot.h>
+
+namespace cache
+{
+
+  namespace
+  {
+
+    const char SnapshotMagic[8] = { 'C', 'A', 'C', 'H', 'E', 'S', 'N', 'P' };
+    const uint32_t SnapshotVersion = 1;
+
+  }
+
+  void SnapshotCodec<std::string>::write(std::ostream& out, const std::string& value)
+  {
+    SnapshotCodec<uint64_t>::write(out, value.size());
+    out.write(value.data(), value.size());
+  }
+
+  const char* SnapshotCodec<std::string>::read(const char* data, const char* end, std::string& value)
+  {
+    uint64_t size;
+    data = SnapshotCodec<uint64_t>::read(data, end, size);
+
+    THROW_IF(static_cast<uint64_t>(end - data) < size, "Snapshot ends within a string of size = ", size);
+
+    value.assign(data, static_cast<size_t>(size));
+
+    return data + size;
+  }
+
+  void write_snapshot_header(std::ostream& out, uint64_t count)
+  {
+    out.write(SnapshotMagic, sizeof(SnapshotMagic));
+    SnapshotCodec<uint32_t>::write(out, SnapshotVersion);
+    SnapshotCodec<uint64_t>::write(out, count);
+  }
+
+  const char* read_snapshot_header(const char* data, const char* end, uint64_t& count)
+  {
+    THROW_IF(static_cast<size_t>(end - data) < sizeof(SnapshotMagic) 
+      || std::memcmp(data, SnapshotMagic, sizeof(SnapshotMagic)) != 0, "Not a cache snapshot!");
+
+    data += sizeof(SnapshotMagic);
+
+    uint32_t version;
+    data = SnapshotCodec<uint32_t>::read(data, end, version);
+    THROW_IF(version != SnapshotVersion, "Unsupported snapshot version = ", version);
+
+    return SnapshotCodec<uint64_t>::read(data, end, count);
+  }
+
+}
@@ -0,0 +1,13 @@
+#include <statistics.h>
+
+namespace cache
+{
+
+  double Statistics::hit_ratio() const noexcept
+  {
+    auto lookups = hits + misses;
+
+    return lookups == 0 ? 0. : static_cast<double>(hits) / lookups;
+  }
+
+}
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace file
 {
@@ -53,6 +55,23 @@ namespace file
      */
     std::string read_line(size_t num) const;
 
+    /**
+     * \brief Reads consecutive lines from the item file in a single pass
+     * \param first - number of the first line to read
+     * \param count - maximum number of lines to read
+     * \return lines read; fewer than count if the end of the file is reached
+     * \throw if the file read has failed
+     */
+    std::vector<std::string> read_lines(size_t first, size_t count) const;
+
+    /**
+     * \brief Reads the lines of specified numbers from the item file in a single pass
+     * \param nums - line numbers in ascending order
+     * \return lines read in the order of nums; lines past the end of the file are not returned
+     * \throw if nums are not in ascending order or the file read has failed
+     */
+    std::vector<std::string> read_lines(const std::vector<size_t>& nums) const;
+
     /**
      * \brief Writes a string to the line of a specified number in the item file
      * \details Since line length is not fixed, the entire file will be rewritten using a temporary file
@@ -71,6 +90,14 @@ namespace file
      */
     void write_line(size_t num, std::string&& str) const; 
 
+    /**
+     * \brief Writes strings to the lines of specified numbers in the item file
+     * \details The entire file is rewritten once using a temporary file regardless of the number of lines
+     * \param lines - strings to write, keyed by line number
+     * \throw if the file write has failed
+     */
+    void write_lines(const std::map<size_t, std::string>& lines) const;
+
     /**
      * \brief Implementation-file-defined default destruction
      * \details Used to enable incomplete type destruction
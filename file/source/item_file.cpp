@@ -4,14 +4,30 @@
 
 #include <utility/exceptions.h>
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
+#include <map>
 #include <type_traits>
+#include <vector>
 
 #include <stdio.h>
 
 namespace file
 {
 
+  namespace
+  {
+
+    utility::LockProfileRef lock_profile()
+    {
+      static utility::LockProfileRef profile = utility::profiled_lock("item_file");
+
+      return profile;
+    }
+
+  }
+
   class ItemFile::Impl
   {
   private:
@@ -29,7 +45,7 @@ namespace file
     >
     Impl(ItemFilePathFwd&& path, bool writeHeavy) try
       : m_path(std::forward<ItemFilePathFwd>(path))
-      , m_lockPolicy(cache::make_lock_policy(writeHeavy))
+      , m_lockPolicy(cache::make_lock_policy(writeHeavy, lock_profile()))
     {
       std::ifstream in(m_path);
 
@@ -65,8 +81,116 @@ namespace file
       RETHROW("Failed to read line number = ", num, " of the ItemFile!");
     }
 
+    std::vector<std::string> read_lines(size_t first, size_t count) const try
+    {
+      std::vector<std::string> result;
+
+      auto end = count > std::numeric_limits<size_t>::max() - first ? std::numeric_limits<size_t>::max() : first + count;
+
+      scan(end, [first, &result] (size_t i, std::string& buffer)
+      {
+        if (i >= first)
+        {
+          result.push_back(std::move(buffer));
+        }
+      });
+
+      return result;
+    }
+    catch (...)
+    {
+      RETHROW("Failed to read ", count, " lines of the ItemFile starting from line number = ", first, "!");
+    }
+
+    std::vector<std::string> read_lines(const std::vector<size_t>& nums) const try
+    {
+      THROW_IF(!std::is_sorted(nums.begin(), nums.end()), "Line numbers are not in ascending order!");
+
+      std::vector<std::string> result;
+      if (nums.empty())
+      {
+        return result;
+      }
+
+      result.reserve(nums.size());
+
+      auto next = nums.begin();
+
+      scan(nums.back() + 1, [&nums, &next, &result] (size_t i, std::string& buffer)
+      {
+        for (; next != nums.end() && *next == i; ++next)
+        {
+          result.push_back(buffer);
+        }
+      });
+
+      return result;
+    }
+    catch (...)
+    {
+      RETHROW("Failed to read ", nums.size(), " lines of the ItemFile!");
+    }
+
     template <typename StrFwd>
-    void write_line(size_t num, StrFwd&& str) const
+    void write_line(size_t num, StrFwd&& str) const try
+    {
+      rewrite(num, [num, &str] (size_t i, std::string& buffer)
+      {
+        if (i == num)
+        {
+          buffer = std::forward<StrFwd>(str);
+        }
+      });
+    }
+    catch (...)
+    {
+      RETHROW("Failed to write line number = ", num, " of the ItemFile!");
+    }
+
+    void write_lines(const std::map<size_t, std::string>& lines) const try
+    {
+      if (lines.empty())
+      {
+        return;
+      }
+
+      auto next = lines.begin();
+
+      rewrite(lines.rbegin()->first, [&lines, &next] (size_t i, std::string& buffer)
+      {
+        if (next != lines.end() && next->first == i)
+        {
+          buffer = next->second;
+          ++next;
+        }
+      });
+    }
+    catch (...)
+    {
+      RETHROW("Failed to write ", lines.size(), " lines of the ItemFile!");
+    }
+
+  private:
+    template <typename Visit>
+    void scan(size_t end, Visit&& visit) const
+    {
+      auto lock = m_lockPolicy->acquire_shared_lock();
+
+      std::ifstream in(m_path);
+      THROW_IF(!in.good(), "Could not open file = ", m_path);
+
+      std::string buffer;
+
+      for (size_t i = 0; i < end && std::getline(in, buffer); ++i)
+      {
+        visit(i, buffer);
+      }
+
+      THROW_IF(in.bad(), "Failed to read from file = ", m_path);
+    }
+
+    template <typename Substitute>
+    void rewrite(size_t last, Substitute&& substitute) const
     {
       auto tempPath = m_path + ".tmp";
 
@@ -82,31 +206,30 @@ namespace file
 
         std::string buffer;
 
-        for (size_t i = 0; i < num; ++i)
+        for (size_t i = 0; i <= last; ++i)
         {
           std::getline(in, buffer);
 
           THROW_IF(!in.good(), "Failed to read line ", i, " from the input file! End of file is "
             , (in.eof() ? "reached" : "not reached"));
 
-          out << buffer << std::endl;
-        }
-
-        std::getline(in, buffer);
+          substitute(i, buffer);
 
-        THROW_IF(!in.good(), "Failed to read line ", num, " from the input file! End of file is "
-          , (in.eof() ? "reached" : "not reached"));
-
-        out << std::forward<StrFwd>(str) << std::endl;
+          out << buffer << '\n';
+        }
 
         while (std::getline(in, buffer))
         {
-          out << buffer << std::endl;
+          out << buffer << '\n';
         }
+
+        out.close();
+        THROW_IF(out.fail(), "Failed to write the temporary file = ", tempPath);
       }
       catch (...)
       {
-        remove(m_path.c_str());
+        out.close();
+        remove(tempPath.c_str());
 
         throw;
       }
@@ -142,6 +265,16 @@ namespace file
     return m_impl->read_line(num);
   } 
 
+  std::vector<std::string> ItemFile::read_lines(size_t first, size_t count) const
+  {
+    return m_impl->read_lines(first, count);
+  }
+
+  std::vector<std::string> ItemFile::read_lines(const std::vector<size_t>& nums) const
+  {
+    return m_impl->read_lines(nums);
+  }
+
   void ItemFile::write_line(size_t num, const std::string& str) const
   {
     return m_impl->write_line(num, str);
@@ -152,6 +285,11 @@ namespace file
     return m_impl->write_line(num, std::move(str));
   }
 
+  void ItemFile::write_lines(const std::map<size_t, std::string>& lines) const
+  {
+    return m_impl->write_lines(lines);
+  }
+
   ItemFile::~ItemFile() = default;
 
 }
@@ -1,19 +1,31 @@
 #include <cache/cache.h>
+#include <cache/fixed_string.h>
+#include <cache/front_cache.h>
+#include <cache/sequential_prefetcher.h>
+#include <cache/memory_guard.h>
 
 #include <file/item_file.h>
 #include <file/reader.h>
 #include <file/writer.h>
 
 #include <utility/exceptions.h>
+#include <utility/histogram.h>
+#include <utility/lock_profile.h>
+#include <utility/periodic_task.h>
+#include <utility/resident_memory.h>
 
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <future>
+#include <iomanip>
 #include <iostream>
 #include <list>
+#include <map>
+#include <numeric>
 #include <memory>
 #include <string>
-#include <tuple>
+#include <thread>
 #include <vector>
 
 namespace
@@ -28,15 +40,92 @@ namespace
     std::string writers;
     std::string items;
     bool writeHeavy;
+    bool rcu;
     bool floatOptimized;
+    bool inlineValues;
     bool realtimeConsistent;
+    bool statistics;
+    size_t checkpoint;
+    std::string json;
+    size_t warmUp;
+    std::string warmUpKeys;
+    size_t warmUpThreads;
+    std::string snapshot;
+    size_t memoryLimit;
+    cache::ShardingOptions sharding;
+    cache::EvictionOptions eviction;
+    bool denseIndex;
+    size_t frontCache;
+    size_t absentTtl;
+    size_t prefetch;
   };
 
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * \brief Latencies (in nanoseconds) recorded by a single reader or writer thread
+   */
+  struct Latencies
+  {
+    utility::Histogram hits;
+    utility::Histogram diskLoads;
+    utility::Histogram writes;
+  };
+
+  struct Workload
+  {
+    std::vector<file::Reader> readers;
+    std::vector<file::Writer> writers;
+    std::unique_ptr<utility::PeriodicTask> checkpoint;
+    std::function<cache::Statistics()> stats;
+    std::function<size_t()> save;
+    std::vector<std::shared_ptr<Latencies>> latencies;
+    std::shared_ptr<void> memoryGuard; ///< declared last to be destroyed before the cache
+  };
+
+  uint64_t elapsed(Clock::time_point since)
+  {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - since).count());
+  }
+
+  bool parse_string_option(const std::string& option, const std::string& name, std::string& value)
+  {
+    auto prefix = name + "=";
+    if (option.compare(0, prefix.size(), prefix) != 0 || option.size() == prefix.size())
+    {
+      return false;
+    }
+
+    value = option.substr(prefix.size());
+
+    return true;
+  }
+
+  bool parse_numeric_option(const std::string& option, const std::string& name, size_t& value)
+  {
+    std::string valueStr;
+    if (!parse_string_option(option, name, valueStr))
+    {
+      return false;
+    }
+
+    try
+    {
+      value = std::stoll(valueStr);
+    }
+    catch (...)
+    {
+      return false;
+    }
+
+    return true;
+  }
+
   bool parse_options(Options& options, int argc, char** argv)
   {
     Options result;
 
-    if (argc < 5 || argc >= 9)
+    if (argc < 5)
     {
       return false;
     }
@@ -55,8 +144,21 @@ namespace
     result.items = argv[4];
 
     result.writeHeavy = false;
+    result.rcu = false;
     result.floatOptimized = false;
+    result.inlineValues = false;
     result.realtimeConsistent = false;
+    result.statistics = false;
+    result.checkpoint = 0;
+    result.warmUp = 0;
+    result.memoryLimit = 0;
+    result.frontCache = 0;
+    result.absentTtl = 0;
+    result.prefetch = 0;
+    result.denseIndex = false;
+    result.warmUpThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    size_t protectedPercent;
 
     for (int i = 5; i < argc; ++i)
     {
@@ -66,14 +168,76 @@ namespace
       {
         result.writeHeavy = true;
       }
+      else if (option == "rcu")
+      {
+        result.rcu = true;
+      }
       else if (option == "float_optimized")
       {
         result.floatOptimized = true;
       }
+      else if (option == "inline_values")
+      {
+        result.inlineValues = true;
+      }
       else if (option == "realtime_consistent")
       {
         result.realtimeConsistent = true;
       }
+      else if (option == "statistics")
+      {
+        result.statistics = true;
+      }
+      else if (parse_numeric_option(option, "checkpoint", result.checkpoint))
+      {
+      }
+      else if (parse_string_option(option, "json", result.json))
+      {
+      }
+      else if (parse_numeric_option(option, "warm_up", result.warmUp))
+      {
+      }
+      else if (parse_string_option(option, "warm_up_keys", result.warmUpKeys))
+      {
+      }
+      else if (parse_string_option(option, "snapshot", result.snapshot))
+      {
+      }
+      else if (parse_numeric_option(option, "memory_limit", result.memoryLimit))
+      {
+      }
+      else if (parse_numeric_option(option, "shards", result.sharding.shardCount) 
+        && result.sharding.shardCount != 0 && result.sharding.shardCount <= result.size)
+      {
+      }
+      else if (option == "numa")
+      {
+        result.sharding.numaAware = true;
+      }
+      else if (option == "dense_index")
+      {
+        result.denseIndex = true;
+      }
+      else if (option == "epoch")
+      {
+        result.eviction.epochReclamation = true;
+      }
+      else if (parse_numeric_option(option, "front_cache", result.frontCache))
+      {
+      }
+      else if (parse_numeric_option(option, "absent_ttl", result.absentTtl))
+      {
+      }
+      else if (parse_numeric_option(option, "prefetch", result.prefetch))
+      {
+      }
+      else if (parse_numeric_option(option, "segmented", protectedPercent) && protectedPercent < 100)
+      {
+        result.eviction.protectedRatio = protectedPercent / 100.;
+      }
+      else if (parse_numeric_option(option, "warm_up_threads", result.warmUpThreads) && result.warmUpThreads != 0)
+      {
+      }
       else
       {
         return false;
@@ -85,237 +249,574 @@ namespace
     return true;
   }
 
-  std::tuple<std::vector<file::Reader>, std::vector<file::Writer>> initialize_readers_and_writers(
-    const Options& options
-  ) try
+  /**
+   * \brief Returns the keys to warm the cache up with in ascending order
+   * \details Keys are read from the warm_up_keys file (one per line) if it is set, otherwise the first warm_up keys are used
+   */
+  std::vector<size_t> warm_up_keys(const Options& options) try
   {
-    auto itemFile = std::make_shared<file::ItemFile>(options.items, options.writeHeavy);
-    std::vector<file::Reader> readers;
-    std::vector<file::Writer> writers;
+    std::vector<size_t> keys;
 
-    if (options.floatOptimized)
+    if (options.warmUpKeys.empty())
     {
-      const float empty = std::numeric_limits<float>::min();
-      const float defaultValue = empty + std::numeric_limits<float>::epsilon();
+      keys.resize(std::min(options.warmUp, options.size));
+      std::iota(keys.begin(), keys.end(), 1);
+
+      return keys;
+    }
 
-      auto updateItemFile = [itemFile, empty, defaultValue] (size_t key, float value)
+    std::ifstream in(options.warmUpKeys);
+    THROW_IF(!in.good(), "Failed to open the warm-up key file = '", options.warmUpKeys, "'!");
+
+    std::string buff;
+    while (std::getline(in, buff))
+    {
+      size_t key;
+      try
       {
-        THROW_IF(key == 0, "Invalid key == 0!");
+        key = std::stoll(buff);
+      }
+      catch (...)
+      {
+        RETHROW("Failed to convert key string = '", buff, "' to an integer!");
+      }
 
-        if (value != defaultValue)
-        {
-          itemFile->write_line(key - 1, value == empty ? std::string() : std::to_string(value));
-        }
-      };
+      THROW_IF(key == 0, "Key = 0 found in the warm-up key file! Item indexing starts from 1");
+
+      keys.push_back(key);
+    }
+
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    return keys;
+  }
+  catch (...)
+  {
+    RETHROW("Failed to collect warm-up keys!");
+  }
+
+  /**
+   * \brief Creates the cache, readers, and writers for values of a given type
+   * \tparam IndexPolicy - index policy of the cache
+   * \param parse - converts a line of the item file to a value, throws if the conversion fails
+   * \param format - converts a value to a line of the item file
+   */
+  template <typename IndexPolicy, typename ValueType, typename Parse, typename Format>
+  Workload create_workload(
+    const Options& options, 
+    const std::shared_ptr<file::ItemFile>& itemFile, 
+    const ValueType& defaultValue, 
+    Parse parse, 
+    Format format
+  ) 
+  {
+    Workload workload;
+
+    auto updateItemFile = [itemFile, format] (size_t key, const ValueType& value)
+    {
+      THROW_IF(key == 0, "Invalid key == 0!");
+
+      itemFile->write_line(key - 1, format(value));
+    };
+
+    auto updateHook = [updateItemFile, realtimeConsistent = options.realtimeConsistent] 
+      (size_t key, const ValueType& value) noexcept
+    {
+      if (realtimeConsistent)
+      {
+        return;
+      }
+
+      try
+      {
+        updateItemFile(key, value);
+      }
+      catch (const std::exception& e)
+      {
+        std::cerr << "Exception in update hook!" << std::endl;
 
-      auto cache = options.realtimeConsistent ?
-      std::make_shared<cache::Cache<size_t, float>>(
-        options.size, 
-        [] (size_t, float) noexcept {},
-        options.writeHeavy,
-        defaultValue
-      ) :  
-      std::make_shared<cache::Cache<size_t, float>>(
-        options.size, 
-        [updateItemFile] (size_t key, float value) noexcept
+        utility::print_exception(e);
+      }
+      catch (...)
+      {
+        std::cerr << "Unknown exception in update hook!" << std::endl;
+      }
+    };
+
+    cache::ItemOptions items(options.writeHeavy);
+    items.rcu = options.rcu;
+
+    auto cache = std::make_shared<cache::Cache<size_t, ValueType, decltype(updateHook), IndexPolicy>>(
+      options.size, 
+      updateHook,
+      items,
+      defaultValue,
+      options.sharding,
+      options.eviction
+    );
+
+    if (!options.snapshot.empty() && std::ifstream(options.snapshot).good())
+    {
+      auto start = Clock::now();
+
+      auto restored = cache->restore(options.snapshot);
+
+      std::cout << "Snapshot: " << restored << " items restored in " 
+                << std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count() << "ms" 
+                << std::endl;
+    }
+
+    auto keys = warm_up_keys(options);
+    if (!keys.empty())
+    {
+      auto start = Clock::now();
+
+      auto loaded = cache->warm_up(
+        keys, 
+        [&itemFile, &parse] (const std::vector<size_t>& keys)
         {
-          try
+          std::vector<size_t> lines(keys.size());
+          std::transform(keys.begin(), keys.end(), lines.begin(), [] (size_t key) { return key - 1; });
+
+          auto contiguous = lines.back() - lines.front() + 1 == lines.size();
+          auto valueStrs = contiguous ? itemFile->read_lines(lines.front(), lines.size()) : itemFile->read_lines(lines);
+
+          std::vector<ValueType> values;
+          values.reserve(valueStrs.size());
+
+          for (const auto& valueStr : valueStrs)
           {
-            updateItemFile(key, value);
+            values.push_back(parse(valueStr));
           }
-          catch (const std::exception& e)
+
+          return values;
+        },
+        options.warmUpThreads
+      );
+
+      std::cout << "Warm-up: " << loaded << " items loaded in " 
+                << std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count() << "ms" 
+                << std::endl;
+    }
+
+    auto checkpoint = [cache, itemFile, format]
+    {
+      cache->flush([&itemFile, &format] (std::vector<std::pair<size_t, ValueType>>& batch) noexcept
+      {
+        try
+        {
+          std::map<size_t, std::string> lines;
+          for (const auto& item : batch)
           {
-            std::cerr << "Exception in update hook!" << std::endl;
+            THROW_IF(item.first == 0, "Invalid key == 0!");
 
-            utility::print_exception(e);
+            lines.emplace(item.first - 1, format(item.second));
           }
-          catch (...)
+
+          itemFile->write_lines(lines);
+        }
+        catch (const std::exception& e)
+        {
+          std::cerr << "Exception in checkpoint!" << std::endl;
+
+          utility::print_exception(e);
+        }
+        catch (...)
+        {
+          std::cerr << "Unknown exception in checkpoint!" << std::endl;
+        }
+      });
+    };
+
+    workload.stats = [cache]
+    {
+      return cache->stats();
+    };
+
+    if (options.checkpoint != 0 && !options.realtimeConsistent)
+    {
+      workload.checkpoint = std::make_unique<utility::PeriodicTask>(std::chrono::milliseconds(options.checkpoint), checkpoint);
+    }
+
+    if (options.memoryLimit != 0)
+    {
+      const size_t highWaterMark = options.memoryLimit << 20;
+
+      workload.memoryGuard = std::make_shared<cache::MemoryGuard<typename decltype(cache)::element_type>>(
+        *cache, 
+        utility::resident_memory, 
+        highWaterMark, 
+        highWaterMark - highWaterMark / 10,
+        100ms,
+        std::max<size_t>(options.size / 16, 1)
+      );
+    }
+
+    if (!options.snapshot.empty())
+    {
+      workload.save = [cache, checkpoint, path = options.snapshot, realtimeConsistent = options.realtimeConsistent]
+      {
+        // persisting modified items first lets them be restored clean, so they are not written again later
+        if (!realtimeConsistent)
+        {
+          checkpoint();
+        }
+
+        return cache->save(path);
+      };
+    }
+
+    {
+      std::fstream in(options.readers);
+      THROW_IF(!in.good(), "Failed to open the reader file = '", options.readers, "'!");
+
+      auto absentTtl = std::chrono::milliseconds(options.absentTtl);
+
+      // loads a range of items with a single pass over the item file
+      auto prefetch = [cache, itemFile, parse, absentTtl] (size_t first, size_t count)
+      {
+        THROW_IF(first == 0, "Invalid key == 0!");
+
+        auto lines = itemFile->read_lines(first - 1, count);
+
+        std::vector<std::pair<size_t, ValueType>> items;
+        items.reserve(lines.size());
+
+        for (size_t i = 0; i < lines.size(); ++i)
+        {
+          if (lines[i].empty())
           {
-            std::cerr << "Unknown exception in update hook!" << std::endl;
+            cache->mark_absent(first + i, absentTtl);
           }
-        },
-        options.writeHeavy,
-        defaultValue
-      );  
+          else
+          {
+            items.emplace_back(first + i, parse(lines[i]));
+          }
+        }
 
+        cache->insert(items.begin(), items.end());
+      };
+
+      std::string buff;
+      while (std::getline(in, buff))
       {
-        std::fstream in(options.readers);
-        THROW_IF(!in.good(), "Failed to open the reader file = '", options.readers, "'!");
+        THROW_IF(in.fail(), "Failed to read fron the reader file = '", options.readers, "'!");
+
+        auto latencies = std::make_shared<Latencies>();
+        workload.latencies.push_back(latencies);
+
+        // each reader runs on its own thread, so it owns its front cache; the deleter keeps the cache alive until then
+        using FrontCache = cache::FrontCache<size_t, ValueType, decltype(updateHook), IndexPolicy>;
+        std::shared_ptr<FrontCache> frontCache;
+        if (options.frontCache != 0)
+        {
+          frontCache.reset(new FrontCache(*cache, options.frontCache), [cache] (FrontCache* ptr) { delete ptr; });
+        }
+
+        std::shared_ptr<cache::SequentialPrefetcher<size_t>> prefetcher;
+        if (options.prefetch != 0)
+        {
+          prefetcher = std::make_shared<cache::SequentialPrefetcher<size_t>>(prefetch, options.prefetch);
+        }
 
-        std::string buff;
-        while (std::getline(in, buff))
+        workload.readers.emplace_back(buff, buff + ".out", 
+          [cache, frontCache, prefetcher, itemFile, latencies, defaultValue, parse, format, absentTtl
+          , epochReclamation = options.eviction.epochReclamation] 
+          (size_t key)
         {
-          THROW_IF(in.fail(), "Failed to read fron the reader file = '", options.readers, "'!");
+          auto start = Clock::now();
 
-          readers.emplace_back(buff, buff + ".out", [cache, itemFile, empty, defaultValue] (size_t key)
+          if (prefetcher)
           {
-            auto ptr = (*cache)[key];
+            prefetcher->access(key);
+          }
 
-            auto value = ptr->read();
+          // a front cache hit references the kept pointer, and a borrowed item no pointer at all,
+          // sparing a reference count update on the hot item
+          typename FrontCache::ItemPtr cachePtr;
+          typename FrontCache::CacheType::Guard guard;
+          typename FrontCache::ItemPtr::element_type* ptr;
 
-            if (value == defaultValue)
-            {
-              THROW_IF(key == 0, "Invalid key == 0!");
-              auto newValueStr = itemFile->read_line(key - 1);
-
-              if (newValueStr.empty())
-              {
-                value = empty;
-              }
-              else
-              {
-                try
-                {
-                  value = std::stof(newValueStr);
-                }
-                catch (...)
-                {
-                  RETHROW("Failed to convert value = '", newValueStr, "' to float! Disable float optimization to proceed");
-                }
-              }
-
-              ptr->compare_exchange(defaultValue, value);
-
-              return newValueStr + " Disk";
-            }
+          if (frontCache)
+          {
+            ptr = frontCache->get(key).get();
+          }
+          else if (epochReclamation)
+          {
+            guard = cache->pin();
+            ptr = cache->borrow(key, guard, true);
+          }
+          else
+          {
+            ptr = (cachePtr = cache->get(key)).get();
+          }
 
-            return std::to_string(value) + " Cache";
-          });
-        }
-      }
-      {
-        std::fstream in(options.writers);
-        THROW_IF(!in.good(), "Failed to open the writer file = '", options.writers, "'!");
+          if (!ptr)
+          {
+            // empty lines are known to be absent, and are not loaded again
+            latencies->hits.record(elapsed(start));
 
-        std::string buff;
-        while (std::getline(in, buff))
-        {
-          THROW_IF(in.fail(), "Failed to read from the writer file = '", options.writers, "'!");
+            return std::string(" Cache");
+          }
 
-          writers.emplace_back(buff, [cache, updateItemFile, realtimeConsistent = options.realtimeConsistent] 
-            (size_t key, const std::string& valueStr)
+          // values are read into a buffer of the reader thread, which keeps its capacity between reads
+          static thread_local ValueType value;
+          ptr->read_into(value);
+
+          if (value == defaultValue)
           {
-            float value;
+            THROW_IF(key == 0, "Invalid key == 0!");
+            auto valueStr = itemFile->read_line(key - 1);
 
-            try
+            if (valueStr.empty())
             {
-              value = std::stof(valueStr);
+              cache->mark_absent(key, absentTtl);
             }
-            catch (...)
+            else
             {
-              RETHROW("Failed to convert value = '", valueStr, "' to float! Disable float optimization to proceed");
+              ptr->populate(defaultValue, parse(valueStr));
             }
 
-            (*cache)[key]->update(value);
+            latencies->diskLoads.record(elapsed(start));
 
-            if (realtimeConsistent)
-            {
-              updateItemFile(key, value);
-            }
-          });
-        }
+            return valueStr + " Disk";
+          }
+
+          latencies->hits.record(elapsed(start));
+
+          return format(value) + " Cache";
+        });
       }
     }
-    else
     {
-      const std::string defaultValue = "NODATA";
+      std::fstream in(options.writers);
+      THROW_IF(!in.good(), "Failed to open the writer file = '", options.writers, "'!");
 
-      auto updateItemFile = [itemFile, defaultValue] (size_t key, const std::string& value)
+      std::string buff;
+      while (std::getline(in, buff))
       {
-        THROW_IF(key == 0, "Invalid key == 0!");
+        THROW_IF(in.fail(), "Failed to read from the writer file = '", options.writers, "'!");
 
-        if (value != defaultValue)
-        {
-          itemFile->write_line(key - 1, value);
-        }
-      };
+        auto latencies = std::make_shared<Latencies>();
+        workload.latencies.push_back(latencies);
 
-      auto cache = options.realtimeConsistent ?
-      std::make_shared<cache::Cache<size_t, std::string>>(
-        options.size, 
-        [] (size_t, std::string) noexcept {},
-        options.writeHeavy,
-        defaultValue
-      ) :  
-      std::make_shared<cache::Cache<size_t, std::string>>(
-        options.size, 
-        [updateItemFile] (size_t key, const std::string& value) noexcept
+        workload.writers.emplace_back(buff, [cache, updateItemFile, latencies, parse, realtimeConsistent = options.realtimeConsistent] 
+          (size_t key, const std::string& valueStr)
         {
-          try
+          auto start = Clock::now();
+
+          auto value = parse(valueStr);
+
+          (*cache)[key]->update(value);
+
+          if (realtimeConsistent)
           {
             updateItemFile(key, value);
           }
-          catch (const std::exception& e)
+
+          latencies->writes.record(elapsed(start));
+        });
+      }
+    }
+
+    return workload;
+  }
+
+  /**
+   * \brief Creates the cache, readers, and writers for values of a given type with the index selected by the options
+   */
+  template <typename ValueType, typename Parse, typename Format>
+  Workload initialize_workload(
+    const Options& options, 
+    const std::shared_ptr<file::ItemFile>& itemFile, 
+    const ValueType& defaultValue, 
+    Parse parse, 
+    Format format
+  )
+  {
+    if (options.denseIndex)
+    {
+      return create_workload<cache::DenseIndexPolicy>(options, itemFile, defaultValue, parse, format);
+    }
+
+    return create_workload<cache::HashIndexPolicy>(options, itemFile, defaultValue, parse, format);
+  }
+
+  Workload initialize_workload(const Options& options) try
+  {
+    auto itemFile = std::make_shared<file::ItemFile>(options.items, options.writeHeavy);
+
+    if (options.floatOptimized)
+    {
+      const float empty = std::numeric_limits<float>::min();
+      const float defaultValue = empty + std::numeric_limits<float>::epsilon();
+
+      return initialize_workload<float>(
+        options, 
+        itemFile, 
+        defaultValue, 
+        [empty] (const std::string& valueStr)
+        {
+          if (valueStr.empty())
           {
-            std::cerr << "Exception in update hook!" << std::endl;
+            return empty;
+          }
 
-            utility::print_exception(e);
+          try
+          {
+            return std::stof(valueStr);
           }
           catch (...)
           {
-            std::cerr << "Unknown exception in update hook!" << std::endl;
+            RETHROW("Failed to convert value = '", valueStr, "' to float! Disable float optimization to proceed");
           }
         },
-        options.writeHeavy,
-        defaultValue
-      );  
+        [empty] (float value)
+        {
+          return value == empty ? std::string() : std::to_string(value);
+        }
+      );
+    }
 
-      {
-        std::fstream in(options.readers);
-        THROW_IF(!in.good(), "Failed to open the reader file = '", options.readers, "'!");
+    if (options.inlineValues)
+    {
+      using InlineValue = cache::FixedString<23>;
 
-        std::string buff;
-        while (std::getline(in, buff))
+      return initialize_workload<InlineValue>(
+        options, 
+        itemFile, 
+        "NODATA", 
+        [] (const std::string& valueStr)
         {
-          THROW_IF(in.fail(), "Failed to read fron the reader file = '", options.readers, "'!");
-
-          readers.emplace_back(buff, buff + ".out", [cache, itemFile, defaultValue] (size_t key)
+          try
           {
-            auto ptr = (*cache)[key];
-            auto value = ptr->read();
+            return InlineValue(valueStr);
+          }
+          catch (...)
+          {
+            RETHROW("Failed to store value = '", valueStr, "' inline! Disable inline values to proceed");
+          }
+        },
+        [] (const InlineValue& value)
+        {
+          return value.str();
+        }
+      );
+    }
 
-            if (value == defaultValue)
-            {
-              THROW_IF(key == 0, "Invalid key == 0!");
-              value = itemFile->read_line(key - 1);
+    return initialize_workload<std::string>(
+      options, 
+      itemFile, 
+      "NODATA", 
+      [] (const std::string& valueStr)
+      {
+        return valueStr;
+      },
+      [] (const std::string& value)
+      {
+        return value;
+      }
+    );
+  }
+  catch (...)
+  {
+    RETHROW("Failed to initialize readers and writers!");
+  }
 
-              ptr->compare_exchange(defaultValue, value);
+  void print_statistics(const cache::Statistics& stats)
+  {
+    std::cout << "Hits: " << stats.hits << std::endl
+              << "Misses: " << stats.misses << std::endl
+              << "Hit ratio: " << stats.hit_ratio() << std::endl
+              << "Evictions: " << stats.evictions << std::endl
+              << "Update hook invocations: " << stats.hookInvocations << std::endl
+              << "Absent hits: " << stats.absentHits << std::endl
+              << "Queue size: " << stats.queueSize << std::endl
+              << "Map size: " << stats.mapSize << std::endl
+              << "Capacity: " << stats.capacity << std::endl
+              << "Absent keys: " << stats.absentSize << std::endl
+              << "Retired items: " << stats.retiredSize << std::endl;
+  }
 
-              return value + " Disk";
-            }
+  void print_latencies(std::ostream& stream, const std::string& title, const utility::Histogram& latencies)
+  {
+    stream << title << ": " << latencies.count() << " operations"
+           << ", mean = " << static_cast<uint64_t>(latencies.mean()) << "ns"
+           << ", p50 = " << latencies.percentile(.5) << "ns"
+           << ", p99 = " << latencies.percentile(.99) << "ns"
+           << ", p999 = " << latencies.percentile(.999) << "ns"
+           << std::endl;
+  }
 
-            return value + " Cache";
-          });
-        }
-      }
-      {
-        std::fstream in(options.writers);
-        THROW_IF(!in.good(), "Failed to open the writer file = '", options.writers, "'!");
+  void write_json_latencies(std::ostream& stream, const std::string& name, const utility::Histogram& latencies)
+  {
+    stream << "  \"" << name << "\": {"
+           << " \"count\": " << latencies.count()
+           << ", \"mean_ns\": " << static_cast<uint64_t>(latencies.mean())
+           << ", \"p50_ns\": " << latencies.percentile(.5)
+           << ", \"p99_ns\": " << latencies.percentile(.99)
+           << ", \"p999_ns\": " << latencies.percentile(.999)
+           << ", \"max_ns\": " << latencies.percentile(1.)
+           << " }";
+  }
 
-        std::string buff;
-        while (std::getline(in, buff))
-        {
-          THROW_IF(in.fail(), "Failed to read from the writer file = '", options.writers, "'!");
+  /**
+   * \brief Merges latencies recorded by all threads and reports them with the overall throughput
+   * \details Must only be called once all reader and writer threads have finished
+   * \param duration - wall time of the run
+   * \param json - path of the JSON file to write the report to, or empty
+   */
+  void report_latencies(
+    const std::vector<std::shared_ptr<Latencies>>& latencies, 
+    Clock::duration duration, 
+    const std::string& json
+  ) try
+  {
+    Latencies total;
+    for (const auto& threadLatencies : latencies)
+    {
+      total.hits.merge(threadLatencies->hits);
+      total.diskLoads.merge(threadLatencies->diskLoads);
+      total.writes.merge(threadLatencies->writes);
+    }
 
-          writers.emplace_back(buff, [cache, updateItemFile, realtimeConsistent = options.realtimeConsistent] 
-            (size_t key, const std::string& value)
-          {
-            (*cache)[key]->update(value);
+    auto operations = total.hits.count() + total.diskLoads.count() + total.writes.count();
+    auto seconds = std::chrono::duration<double>(duration).count();
+    auto throughput = seconds > 0 ? operations / seconds : 0.;
 
-            if (realtimeConsistent)
-            {
-              updateItemFile(key, value);
-            }
-          });
-        }
-      }
+    std::cout << "Throughput: " << operations << " operations in " << seconds << "s"
+              << " (" << static_cast<uint64_t>(throughput) << " operations/s)" << std::endl;
+
+    print_latencies(std::cout, "Cache hits", total.hits);
+    print_latencies(std::cout, "Disk loads", total.diskLoads);
+    print_latencies(std::cout, "Writes", total.writes);
+
+    if (json.empty())
+    {
+      return;
     }
 
-    return { std::move(readers), std::move(writers) };
+    std::ofstream out(json, std::ios_base::trunc);
+    THROW_IF(!out.good(), "Failed to open the JSON file = '", json, "'!");
+
+    out << "{" << std::endl
+        << "  \"operations\": " << operations << "," << std::endl
+        << "  \"duration_s\": " << std::setprecision(6) << seconds << "," << std::endl
+        << "  \"throughput\": " << static_cast<uint64_t>(throughput) << "," << std::endl;
+    write_json_latencies(out, "cache_hits", total.hits);
+    out << "," << std::endl;
+    write_json_latencies(out, "disk_loads", total.diskLoads);
+    out << "," << std::endl;
+    write_json_latencies(out, "writes", total.writes);
+    out << std::endl << "}" << std::endl;
+
+    out.close();
+    THROW_IF(out.fail(), "Failed to write the JSON file = '", json, "'!");
   }
   catch (...)
   {
-    RETHROW("Failed to initialize readers and writers!");
+    RETHROW("Failed to report latencies!");
   }
 
 }
@@ -329,17 +830,35 @@ int main(int argc, char** argv) try
               << argv[0] 
               << " <size_of_cache> <reader_file> <writer_file> <items_file>"
               << " <write_heavy/read_heavy (optional; default = read_heavy)>"
+              << " <rcu (optional)>"
               << " <float_optimized (optional)>"
+              << " <inline_values (optional)>"
               << " <realtime_consistent (optional)>"
+              << " <statistics (optional)>"
+              << " <checkpoint=<milliseconds> (optional)>"
+              << " <json=<path> (optional)>"
+              << " <warm_up=<number_of_items> (optional)>"
+              << " <warm_up_keys=<key_file> (optional)>"
+              << " <warm_up_threads=<number_of_threads> (optional)>"
+              << " <snapshot=<path> (optional)>"
+              << " <memory_limit=<megabytes> (optional)>"
+              << " <shards=<number_of_shards> (optional; default = 1)>"
+              << " <numa (optional)>"
+              << " <front_cache=<number_of_slots> (optional)>"
+              << " <absent_ttl=<milliseconds> (optional)>"
+              << " <prefetch=<number_of_items> (optional)>"
+              << " <segmented=<protected_percent> (optional)>"
+              << " <dense_index (optional)>"
+              << " <epoch (optional)>"
               << std::endl;
 
     return 1;
   }
 
-  auto readersAndWriters = initialize_readers_and_writers(options);
+  auto workload = initialize_workload(options);
 
-  auto& readers = std::get<0>(readersAndWriters);
-  auto& writers = std::get<1>(readersAndWriters);
+  auto& readers = workload.readers;
+  auto& writers = workload.writers;
 
   std::atomic<bool> stopFlag;
   stopFlag.store(false);
@@ -379,9 +898,10 @@ int main(int argc, char** argv) try
     );
   }
 
+  auto start = Clock::now();
   startPromise.set_value();
 
-  while (!readerFutures.empty() && !writerFutures.empty()) try
+  while (!readerFutures.empty() || !writerFutures.empty()) try
   {
     readerFutures.remove_if([] (auto& future)
     {
@@ -442,6 +962,22 @@ int main(int argc, char** argv) try
     throw;
   }
 
+  report_latencies(workload.latencies, Clock::now() - start, options.json);
+
+  if (workload.save)
+  {
+    std::cout << "Snapshot: " << workload.save() << " items saved" << std::endl;
+  }
+
+  if (options.statistics)
+  {
+    print_statistics(workload.stats());
+  }
+
+#ifdef CACHE_LOCK_PROFILING
+  utility::print_lock_profiles(std::cout);
+#endif
+
 }
 catch (const std::exception& e)
 {
@@ -1,10 +1,20 @@
 #include <cache/cache.h>
 
+#include <utility/numa.h>
+#include <utility/periodic_task.h>
+
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
 #include <functional>
+#include <iterator>
 #include <future>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -14,6 +24,18 @@ namespace
 
   using namespace cache;
 
+  struct StatelessUpdateHook
+  {
+    void operator()(const int&, const std::string&, UpdateReason) const noexcept
+    {
+      ++calls;
+    }
+
+    static int calls;
+  };
+
+  int StatelessUpdateHook::calls = 0;
+
   class CacheFixture : protected Cache<int, std::string>
                      , public ::testing::Test
   {
@@ -479,4 +501,1346 @@ namespace
     EXPECT_EQ("default", ptr->read());
   }
 
+  TEST(CacheTests, CleanItemsSkipUpdateHook)
+  {
+    std::vector<int> keys;
+
+    {
+      Cache<int, std::string> cache(
+        2, 
+        [&keys] (const int& key, const std::string&) noexcept
+        {
+          keys.push_back(key);
+        },
+        false
+      );
+
+      auto ptr = cache[1];
+      ptr->read();
+
+      ptr = cache[2];
+      ptr->populate("", "loaded");
+      EXPECT_EQ("loaded", ptr->read());
+
+      ptr = cache[3];
+      ptr->update("abc");
+
+      ptr = cache[4];
+      ptr->compare_exchange("no match", "bcd");
+      EXPECT_TRUE(keys.empty());
+
+      ptr = cache[5];
+    }
+
+    ASSERT_EQ(1, keys.size());
+    EXPECT_EQ(3, keys[0]);
+  }
+
+  TEST(CacheTests, UpdateReason)
+  {
+    std::unordered_map<int, UpdateReason> reasons;
+
+    {
+      Cache<int, std::string> cache(
+        2, 
+        [&reasons] (const int& key, const std::string&, UpdateReason reason) noexcept
+        {
+          reasons[key] = reason;
+        },
+        false
+      );
+
+      cache[1]->update("abc");
+      cache[2]->update("bcd");
+      cache[3]->update("cde");
+
+      ASSERT_EQ(1, reasons.size());
+      EXPECT_EQ(UpdateReason::Evicted, reasons[1]);
+    }
+
+    ASSERT_EQ(3, reasons.size());
+    EXPECT_EQ(UpdateReason::Destroyed, reasons[2]);
+    EXPECT_EQ(UpdateReason::Destroyed, reasons[3]);
+  }
+
+  TEST(CacheTests, StatelessUpdateHook)
+  {
+    StatelessUpdateHook::calls = 0;
+
+    {
+      auto cache = make_cache<int, std::string>(2, StatelessUpdateHook());
+
+      (*cache)[1]->update("abc");
+      (*cache)[2]->update("bcd");
+      (*cache)[3]->read();
+      EXPECT_EQ(1, StatelessUpdateHook::calls);
+    }
+
+    EXPECT_EQ(2, StatelessUpdateHook::calls);
+  }
+
+  TEST(CacheTests, StatefulUpdateHookOutlivesCache)
+  {
+    std::vector<std::string> values;
+
+    auto cache = make_cache<int, std::string>(
+      2, 
+      [&values] (const int&, const std::string& value) noexcept
+      {
+        values.push_back(value);
+      }
+    );
+
+    auto ptr = (*cache)[1];
+    cache.reset();
+    EXPECT_TRUE(values.empty());
+
+    ptr->update("abc");
+    ptr.reset();
+
+    ASSERT_EQ(1, values.size());
+    EXPECT_EQ("abc", values[0]);
+  }
+
+  TEST(CacheTests, Flush)
+  {
+    std::unordered_map<int, std::string> values;
+    std::vector<UpdateReason> reasons;
+
+    Cache<int, std::string> cache(
+      3, 
+      [&values, &reasons] (const int& key, const std::string& value, UpdateReason reason) noexcept
+      {
+        values[key] = value;
+        reasons.push_back(reason);
+      },
+      false
+    );
+
+    cache[1]->update("abc");
+    cache[2]->read();
+    cache[3]->update("cde");
+
+    EXPECT_EQ(2, cache.flush());
+    ASSERT_EQ(2, values.size());
+    EXPECT_EQ("abc", values[1]);
+    EXPECT_EQ("cde", values[3]);
+    EXPECT_EQ(std::vector<UpdateReason>({ UpdateReason::Flushed, UpdateReason::Flushed }), reasons);
+
+    EXPECT_EQ(0, cache.flush());
+
+    values.clear();
+    reasons.clear();
+    cache[3]->update("def");
+    cache[4]->read();
+    cache[5]->read();
+    EXPECT_TRUE(values.empty());
+
+    cache[6]->read();
+    ASSERT_EQ(1, values.size());
+    EXPECT_EQ("def", values[3]);
+    EXPECT_EQ(std::vector<UpdateReason>({ UpdateReason::Evicted }), reasons);
+  }
+
+  TEST(CacheTests, BatchFlush)
+  {
+    Cache<int, int> cache(
+      100, 
+      [] (const int&, const int&) noexcept
+      {
+      }
+    );
+
+    for (int i = 0; i < 50; ++i)
+    {
+      cache[i]->update(i * 2);
+    }
+
+    std::unordered_map<int, int> values;
+    size_t batches = 0;
+
+    auto flushed = cache.flush([&values, &batches] (std::vector<std::pair<int, int>>& batch) noexcept
+    {
+      EXPECT_LE(batch.size(), 8);
+      values.insert(batch.begin(), batch.end());
+      ++batches;
+    }, 8);
+
+    EXPECT_EQ(50, flushed);
+    EXPECT_EQ(50, values.size());
+    EXPECT_LE(7, batches);
+
+    for (int i = 0; i < 50; ++i)
+    {
+      EXPECT_EQ(i * 2, values[i]);
+      EXPECT_FALSE(cache[i]->dirty());
+    }
+  }
+
+  TEST(CacheTests, FlushWhileLookedUp)
+  {
+    Cache<int, int> cache(
+      300, 
+      [] (const int&, const int&) noexcept
+      {
+      }
+    );
+
+    for (int i = 0; i < 300; ++i)
+    {
+      cache[i]->update(i);
+    }
+
+    std::unordered_map<int, int> flushes;
+
+    // the shard is unlocked between batches, so lookups reorder items not flushed yet as well as flushed ones
+    auto flushed = cache.flush([&cache, &flushes] (std::vector<std::pair<int, int>>& batch) noexcept
+    {
+      for (const auto& item : batch)
+      {
+        ++flushes[item.first];
+      }
+
+      for (int i = 0; i < 300; i += 7)
+      {
+        cache.visit(i, [] (Item<int>&) {});
+      }
+    }, 10);
+
+    EXPECT_EQ(300, flushed);
+    EXPECT_EQ(300, flushes.size());
+
+    for (const auto& flush : flushes)
+    {
+      EXPECT_EQ(1, flush.second);
+    }
+  }
+
+  TEST(CacheTests, PeriodicFlushMT)
+  {
+    std::atomic<int> flushed(0);
+
+    Cache<int, int> cache(
+      10, 
+      [&flushed] (const int&, const int&, UpdateReason reason) noexcept
+      {
+        if (reason == UpdateReason::Flushed)
+        {
+          ++flushed;
+        }
+      }
+    );
+
+    {
+      utility::PeriodicTask checkpoint(std::chrono::milliseconds(1), [&cache] { cache.flush(); });
+
+      for (int i = 0; i < 10000; ++i)
+      {
+        cache[rand() % 20]->update(i);
+      }
+
+      auto start = std::chrono::steady_clock::now();
+      while (flushed.load() == 0 && std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+
+    EXPECT_LT(0, flushed.load());
+  }
+
+  TEST(CacheTests, Statistics)
+  {
+    Cache<int, std::string> cache(
+      2, 
+      [] (const int&, const std::string&) noexcept
+      {
+      },
+      false
+    );
+
+    auto stats = cache.stats();
+    EXPECT_EQ(0, stats.hits);
+    EXPECT_EQ(0, stats.misses);
+    EXPECT_EQ(0., stats.hit_ratio());
+
+    cache[1]->update("abc");
+    cache[1]->read();
+    cache[2]->read();
+    cache[3]->read();
+    cache[4]->read();
+    cache[4]->update("bcd");
+    EXPECT_EQ(1, cache.flush());
+
+    stats = cache.stats();
+    EXPECT_EQ(2, stats.hits);
+    EXPECT_EQ(4, stats.misses);
+    EXPECT_EQ(2, stats.evictions);
+    EXPECT_EQ(2, stats.hookInvocations);
+    EXPECT_EQ(2, stats.queueSize);
+    EXPECT_EQ(2, stats.mapSize);
+    EXPECT_EQ(2, stats.capacity);
+    EXPECT_DOUBLE_EQ(2. / 6., stats.hit_ratio());
+  }
+
+  TEST(CacheTests, StatisticsMT)
+  {
+    Cache<int, int> cache(
+      10, 
+      [] (const int&, const int&) noexcept
+      {
+      }
+    );
+
+    std::promise<void> promise;
+    auto signal = promise.get_future().share();
+
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 20; ++i)
+    {
+      futures.push_back(std::async(std::launch::async, [&cache, signal]
+      {
+        signal.wait();
+
+        for (int i = 0; i < 10000; ++i)
+        {
+          cache[rand() % 20]->read();
+        }
+      }));
+    }
+
+    promise.set_value();
+
+    for (auto& future : futures)
+    {
+      future.get();
+    }
+
+    auto stats = cache.stats();
+    EXPECT_EQ(200000, stats.hits + stats.misses);
+    EXPECT_EQ(stats.misses - 10, stats.evictions);
+    EXPECT_EQ(0, stats.hookInvocations);
+    EXPECT_EQ(10, stats.queueSize);
+  }
+
+  TEST(CacheTests, Insert)
+  {
+    std::unordered_map<int, std::string> values;
+
+    Cache<int, std::string> cache(
+      3, 
+      [&values] (const int& key, const std::string& value) noexcept
+      {
+        values[key] = value;
+      },
+      false
+    );
+
+    cache[1]->update("abc");
+
+    std::vector<std::pair<int, std::string>> items({ { 1, "x" }, { 2, "bcd" }, { 3, "cde" }, { 2, "y" } });
+    EXPECT_EQ(2, cache.insert(items.begin(), items.end()));
+
+    EXPECT_EQ("abc", cache[1]->read());
+    EXPECT_EQ("bcd", cache[2]->read());
+    EXPECT_EQ("cde", cache[3]->read());
+    EXPECT_EQ(1, cache.flush());
+
+    values.clear();
+    items = { { 4, "def" }, { 5, "efg" } };
+    EXPECT_EQ(2, cache.insert(items.begin(), items.end()));
+    EXPECT_TRUE(values.empty());
+
+    EXPECT_EQ("cde", cache[3]->read());
+    EXPECT_EQ("def", cache[4]->read());
+    EXPECT_EQ("efg", cache[5]->read());
+    EXPECT_EQ(3, cache.stats().queueSize);
+  }
+
+  TEST(CacheTests, WarmUpMT)
+  {
+    Cache<int, std::string> cache(
+      100, 
+      [] (const int&, const std::string&) noexcept
+      {
+      },
+      false
+    );
+
+    std::vector<int> keys(150);
+    std::iota(keys.begin(), keys.end(), 1);
+
+    std::atomic<int> calls(0);
+    auto loaded = cache.warm_up(keys, [&calls] (const std::vector<int>& keys)
+    {
+      ++calls;
+
+      std::vector<std::string> values;
+      for (auto key : keys)
+      {
+        if (key > 90)
+        {
+          break;
+        }
+
+        values.push_back(std::to_string(key));
+      }
+
+      return values;
+    }, 4, 8);
+
+    EXPECT_EQ(4, calls);
+    EXPECT_EQ(90, loaded);
+
+    auto stats = cache.stats();
+    EXPECT_EQ(90, stats.queueSize);
+    EXPECT_EQ(0, stats.evictions);
+
+    for (int key = 1; key <= 90; ++key)
+    {
+      EXPECT_EQ(std::to_string(key), cache[key]->read());
+    }
+
+    EXPECT_EQ("", cache[91]->read());
+    EXPECT_EQ(0, cache.flush());
+
+    EXPECT_ANY_THROW(cache.warm_up(keys, [] (const std::vector<int>& keys)
+    {
+      return std::vector<std::string>(keys.size() + 1);
+    }, 2));
+  }
+
+  TEST(CacheTests, Snapshot)
+  {
+    std::unordered_map<int, std::string> values;
+    auto hook = [&values] (const int& key, const std::string& value) noexcept
+    {
+      values[key] = value;
+    };
+
+    {
+      Cache<int, std::string> cache(4, hook, false);
+
+      cache[1]->update("abc");
+      cache[2]->populate("", "bcd");
+      cache[3]->populate("", "");
+      cache[4]->update("def");
+      cache[1]->read();
+
+      EXPECT_EQ(4, cache.save("test_cache_snapshot.bin"));
+      EXPECT_EQ(2, cache.flush());
+    }
+
+    values.clear();
+
+    {
+      Cache<int, std::string> cache(4, hook, false);
+      cache[2]->update("new");
+
+      EXPECT_EQ(3, cache.restore("test_cache_snapshot.bin"));
+      EXPECT_EQ(1, cache.stats().misses);
+
+      EXPECT_EQ("new", cache[2]->read());
+      EXPECT_EQ("", cache[3]->read());
+      EXPECT_EQ("def", cache[4]->read());
+      EXPECT_EQ("abc", cache[1]->read());
+      EXPECT_EQ(1, cache.stats().misses);
+
+      EXPECT_EQ(3, cache.flush());
+      EXPECT_EQ("abc", values[1]);
+      EXPECT_EQ("new", values[2]);
+      EXPECT_EQ("def", values[4]);
+    }
+
+    values.clear();
+
+    {
+      Cache<int, std::string> cache(1, hook, false);
+
+      // dirty items evicted in favour of more recent ones reach the update hook
+      EXPECT_EQ(4, cache.restore("test_cache_snapshot.bin"));
+      ASSERT_EQ(1, values.size());
+      EXPECT_EQ("def", values[4]);
+      EXPECT_EQ("abc", cache[1]->read());
+      EXPECT_EQ(0, cache.stats().misses);
+    }
+
+    ASSERT_EQ(2, values.size());
+    EXPECT_EQ("abc", values[1]);
+    EXPECT_EQ("def", values[4]);
+
+    Cache<int, float> floatCache(2, [] (const int&, const float&) noexcept
+    {
+    });
+    floatCache[7]->update(1.5f);
+    EXPECT_EQ(1, floatCache.save("test_cache_snapshot.bin"));
+
+    Cache<int, float> restoredFloatCache(2, [] (const int&, const float&) noexcept
+    {
+    });
+    EXPECT_EQ(1, restoredFloatCache.restore("test_cache_snapshot.bin"));
+    EXPECT_EQ(1.5f, restoredFloatCache[7]->read());
+  }
+
+  TEST(CacheTests, SnapshotSharded)
+  {
+    std::unordered_map<int, std::string> values;
+    auto hook = [&values] (const int& key, const std::string& value) noexcept
+    {
+      values[key] = value;
+    };
+
+    {
+      Cache<int, std::string> cache(40, hook, false, "", { 2, false });
+
+      for (int key = 0; key < 20; ++key)
+      {
+        cache[key]->update(std::to_string(key));
+      }
+
+      EXPECT_EQ(20, cache.save("test_cache_snapshot.bin"));
+      EXPECT_EQ(20, cache.flush());
+    }
+
+    values.clear();
+
+    {
+      Cache<int, std::string> cache(2, hook, false, "", { 2, false });
+
+      EXPECT_EQ(20, cache.restore("test_cache_snapshot.bin"));
+      EXPECT_EQ(18, values.size());
+
+      // only the most recently used item of each shard is kept
+      std::vector<int> latest(cache.shard_count(), -1);
+      for (int key = 0; key < 20; ++key)
+      {
+        latest[cache.shard_of(key)] = key;
+      }
+
+      for (auto key : latest)
+      {
+        ASSERT_NE(-1, key);
+        EXPECT_EQ(0, values.count(key));
+        EXPECT_EQ(std::to_string(key), cache[key]->read());
+      }
+
+      EXPECT_EQ(0, cache.stats().misses);
+    }
+
+    EXPECT_EQ(20, values.size());
+  }
+
+  TEST(CacheTests, SnapshotMalformed)
+  {
+    Cache<int, std::string> cache(4, [] (const int&, const std::string&) noexcept
+    {
+    });
+
+    EXPECT_ANY_THROW(cache.restore("test_cache_snapshot_missing.bin"));
+
+    cache[1]->update("abc");
+    cache.save("test_cache_snapshot.bin");
+
+    {
+      std::ifstream in("test_cache_snapshot.bin", std::ios_base::binary);
+      std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+      std::ofstream("test_cache_snapshot_truncated.bin", std::ios_base::binary | std::ios_base::trunc)
+        << contents.substr(0, contents.size() - 1);
+      std::ofstream("test_cache_snapshot_invalid.bin", std::ios_base::binary | std::ios_base::trunc)
+        << "abc" << contents;
+
+      std::ofstream overflow("test_cache_snapshot_overflow.bin", std::ios_base::binary | std::ios_base::trunc);
+      write_snapshot_header(overflow, uint64_t(1) << 40);
+    }
+
+    EXPECT_ANY_THROW(cache.restore("test_cache_snapshot_truncated.bin"));
+    EXPECT_ANY_THROW(cache.restore("test_cache_snapshot_invalid.bin"));
+    EXPECT_ANY_THROW(cache.restore("test_cache_snapshot_overflow.bin"));
+    EXPECT_EQ(1, cache.stats().queueSize);
+  }
+
+  TEST(CacheTests, Resize)
+  {
+    std::unordered_map<int, std::string> values;
+    std::vector<UpdateReason> reasons;
+
+    Cache<int, std::string> cache(
+      4, 
+      [&values, &reasons] (const int& key, const std::string& value, UpdateReason reason) noexcept
+      {
+        values[key] = value;
+        reasons.push_back(reason);
+      },
+      false
+    );
+
+    cache[1]->update("abc");
+    cache[2]->read();
+    cache[3]->update("cde");
+    cache[4]->read();
+
+    EXPECT_ANY_THROW(cache.resize(0));
+
+    cache.resize(2);
+    EXPECT_EQ(2, cache.stats().capacity);
+    EXPECT_EQ(2, cache.stats().queueSize);
+    EXPECT_EQ(2, cache.stats().evictions);
+    ASSERT_EQ(1, values.size());
+    EXPECT_EQ("abc", values[1]);
+    EXPECT_EQ(std::vector<UpdateReason>({ UpdateReason::Evicted }), reasons);
+
+    EXPECT_EQ("cde", cache[3]->read());
+    EXPECT_EQ("", cache[4]->read());
+    EXPECT_EQ(4, cache.stats().misses);
+
+    cache.resize(3);
+    cache[5]->read();
+    EXPECT_EQ(3, cache.stats().queueSize);
+    EXPECT_EQ(2, cache.stats().evictions);
+
+    cache[6]->read();
+    EXPECT_EQ(3, cache.stats().queueSize);
+    EXPECT_EQ(3, cache.stats().evictions);
+    ASSERT_EQ(2, values.size());
+    EXPECT_EQ("cde", values[3]);
+  }
+
+  TEST(CacheTests, ResizeMT)
+  {
+    Cache<int, std::string> cache(
+      1000, 
+      [] (const int&, const std::string&) noexcept
+      {
+      },
+      false
+    );
+
+    std::atomic<bool> stop(false);
+    std::vector<std::future<void>> futures;
+
+    for (int i = 0; i < 4; ++i)
+    {
+      futures.push_back(std::async(std::launch::async, [&cache, &stop, i]
+      {
+        for (int key = i; !stop; key = (key + 7) % 5000)
+        {
+          cache[key]->update(std::to_string(key));
+        }
+      }));
+    }
+
+    for (size_t size : { 100, 2000, 10, 500, 1 })
+    {
+      cache.resize(size);
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    stop = true;
+    for (auto& future : futures)
+    {
+      future.get();
+    }
+
+    auto stats = cache.stats();
+    EXPECT_EQ(1, stats.capacity);
+    EXPECT_GE(2, stats.queueSize);
+    EXPECT_EQ(stats.queueSize, stats.mapSize);
+
+    cache.resize(1);
+    EXPECT_EQ(1, cache.stats().queueSize);
+  }
+
+  TEST(CacheTests, Sharded)
+  {
+    std::unordered_map<int, std::string> values;
+
+    EXPECT_ANY_THROW((Cache<int, std::string>(4, [] (const int&, const std::string&) noexcept {}, false, "", { 0, false })));
+    EXPECT_ANY_THROW((Cache<int, std::string>(3, [] (const int&, const std::string&) noexcept {}, false, "", { 4, false })));
+
+    Cache<int, std::string> cache(
+      10, 
+      [&values] (const int& key, const std::string& value) noexcept
+      {
+        values[key] = value;
+      },
+      false,
+      "",
+      { 4, true }
+    );
+
+    EXPECT_EQ(4, cache.shard_count());
+    EXPECT_EQ(10, cache.stats().capacity);
+    EXPECT_ANY_THROW(cache.shard_node(4));
+
+    std::vector<size_t> shardSizes(cache.shard_count());
+    for (int key = 0; key < 100; ++key)
+    {
+      EXPECT_EQ(cache.shard_of(key), cache.shard_of(key));
+      EXPECT_GT(utility::numa_node_count(), cache.shard_node(cache.shard_of(key)));
+
+      ++shardSizes[cache.shard_of(key)];
+      cache[key]->update(std::to_string(key));
+    }
+
+    // each shard holds 3 or 2 items and evicts its own least recently used ones
+    EXPECT_EQ(0, std::count(shardSizes.begin(), shardSizes.end(), 0));
+    EXPECT_EQ(10, cache.stats().queueSize);
+    EXPECT_EQ(90, values.size());
+
+    for (int key = 99; key >= 0; --key)
+    {
+      if (values.count(key) == 0)
+      {
+        EXPECT_EQ(std::to_string(key), cache[key]->read());
+      }
+    }
+
+    EXPECT_EQ(10, cache.stats().hits);
+
+    EXPECT_EQ(10, cache.flush());
+    EXPECT_EQ(100, values.size());
+
+    cache.resize(4);
+    EXPECT_EQ(4, cache.stats().capacity);
+    EXPECT_EQ(4, cache.stats().queueSize);
+    EXPECT_ANY_THROW(cache.resize(3));
+
+    std::vector<std::pair<int, std::string>> items({ { 101, "a" }, { 102, "b" }, { 103, "c" } });
+    cache.resize(8);
+    EXPECT_EQ(8, cache.stats().capacity);
+    EXPECT_EQ(3, cache.insert(items.begin(), items.end()));
+    EXPECT_EQ("a", cache[101]->read());
+  }
+
+  TEST(CacheTests, ShardedMT)
+  {
+    std::atomic<size_t> evicted(0);
+
+    Cache<int, int> cache(
+      1000, 
+      [&evicted] (const int& key, const int& value) noexcept
+      {
+        EXPECT_EQ(key, value);
+        ++evicted;
+      },
+      true,
+      0,
+      { 8, true }
+    );
+
+    std::vector<std::future<void>> futures;
+
+    for (int i = 0; i < 8; ++i)
+    {
+      futures.push_back(std::async(std::launch::async, [&cache, i]
+      {
+        for (int key = i; key < 100000; key += 8)
+        {
+          cache[key % 3000]->update(key % 3000);
+        }
+      }));
+    }
+
+    for (auto& future : futures)
+    {
+      future.get();
+    }
+
+    auto stats = cache.stats();
+    EXPECT_EQ(1000, stats.queueSize);
+    EXPECT_EQ(1000, stats.mapSize);
+    EXPECT_EQ(stats.evictions, evicted.load());
+    EXPECT_EQ(100000, stats.hits + stats.misses);
+  }
+
+  TEST(CacheTests, Absent)
+  {
+    std::unordered_map<int, std::string> values;
+
+    Cache<int, std::string> cache(
+      2, 
+      [&values] (const int& key, const std::string& value) noexcept
+      {
+        values[key] = value;
+      }
+    );
+
+    EXPECT_FALSE(cache.absent(1));
+    EXPECT_TRUE(cache.mark_absent(1));
+    EXPECT_TRUE(cache.absent(1));
+    EXPECT_EQ(nullptr, cache.get(1));
+    EXPECT_EQ(nullptr, cache.get(1));
+
+    auto stats = cache.stats();
+    EXPECT_EQ(3, stats.absentHits);
+    EXPECT_EQ(0, stats.misses);
+    EXPECT_EQ(0, stats.queueSize);
+    EXPECT_EQ(1, stats.absentSize);
+
+    // a clean item is dropped in favour of the absence, a dirty one is kept
+    cache[2]->populate("", "abc");
+    EXPECT_TRUE(cache.mark_absent(2));
+    EXPECT_EQ(0, cache.stats().queueSize);
+    cache[3]->update("cde");
+    EXPECT_FALSE(cache.mark_absent(3));
+    EXPECT_EQ("cde", cache.get(3)->read());
+
+    // writing a value ends the absence
+    cache[1]->update("a");
+    EXPECT_FALSE(cache.absent(1));
+    EXPECT_EQ("a", cache.get(1)->read());
+
+    std::vector<std::pair<int, std::string>> items({ { 2, "b" } });
+    EXPECT_EQ(1, cache.insert(items.begin(), items.end()));
+    EXPECT_EQ("b", cache.get(2)->read());
+    EXPECT_EQ(0, cache.stats().absentSize);
+    ASSERT_EQ(1, values.size());
+    EXPECT_EQ("cde", values[3]);
+
+    // absences are bounded by the size of the cache, expired ones being dropped first
+    EXPECT_TRUE(cache.mark_absent(10, std::chrono::milliseconds(1)));
+    EXPECT_TRUE(cache.mark_absent(11));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_TRUE(cache.mark_absent(12));
+    EXPECT_FALSE(cache.absent(10));
+    EXPECT_TRUE(cache.absent(11));
+    EXPECT_TRUE(cache.absent(12));
+
+    EXPECT_TRUE(cache.mark_absent(13));
+    EXPECT_EQ(1, cache.stats().absentSize);
+    EXPECT_TRUE(cache.absent(13));
+
+    EXPECT_NE(nullptr, cache[11]);
+    EXPECT_GT(cache.memory_usage(), 0);
+  }
+
+  TEST(CacheTests, Segmented)
+  {
+    auto hook = [] (const int&, const int&) noexcept {};
+
+    EXPECT_ANY_THROW((Cache<int, int>(10, hook, false, 0, ShardingOptions(), { 1. })));
+    EXPECT_ANY_THROW((Cache<int, int>(10, hook, false, 0, ShardingOptions(), { -.5 })));
+
+    std::vector<int> evicted;
+
+    Cache<int, int> cache(
+      10, 
+      [&evicted] (const int& key, const int&) noexcept
+      {
+        evicted.push_back(key);
+      },
+      false,
+      0,
+      ShardingOptions(),
+      { .5 }
+    );
+
+    // the hot set is hit twice, becoming protected
+    for (int round = 0; round < 2; ++round)
+    {
+      for (int key = 0; key < 5; ++key)
+      {
+        cache[key]->update(key);
+      }
+    }
+
+    // a long scan only displaces probationary items
+    for (int key = 100; key < 200; ++key)
+    {
+      cache[key]->update(key);
+    }
+
+    EXPECT_EQ(10, cache.stats().queueSize);
+    EXPECT_EQ(95, evicted.size());
+    EXPECT_TRUE(std::none_of(evicted.begin(), evicted.end(), [] (int key) { return key < 5; }));
+
+    for (int key = 0; key < 5; ++key)
+    {
+      EXPECT_EQ(key, cache[key]->read());
+    }
+
+    EXPECT_EQ(10, cache.stats().hits);
+
+    // protected items exceeding the protected share are demoted, and evicted first among protected items
+    cache[195];
+    cache[196];
+    evicted.clear();
+
+    for (int key = 200; key < 205; ++key)
+    {
+      cache[key]->update(key);
+    }
+
+    EXPECT_EQ(std::vector<int>({ 197, 198, 199, 0, 1 }), evicted);
+
+    // shrinking demotes protected items to keep the share
+    cache.resize(4);
+    EXPECT_EQ(4, cache.stats().queueSize);
+    cache.resize(10);
+
+    for (int key = 300; key < 310; ++key)
+    {
+      cache[key];
+    }
+
+    EXPECT_EQ(10, cache.stats().queueSize);
+  }
+
+  TEST(CacheTests, SegmentedMT)
+  {
+    Cache<int, int> cache(100, [] (const int&, const int&) noexcept {}, false, 0, { 4, false }, { .8 });
+
+    std::vector<std::future<void>> futures;
+
+    for (int i = 0; i < 4; ++i)
+    {
+      futures.push_back(std::async(std::launch::async, [&cache, i]
+      {
+        for (int j = 0; j < 20000; ++j)
+        {
+          auto key = j % 2 ? j / 2 % 20 : 1000 + i * 20000 + j;
+          cache[key]->update(key);
+        }
+      }));
+    }
+
+    for (auto& future : futures)
+    {
+      future.get();
+    }
+
+    // the hot keys fit into the protected segments despite the scans
+    for (int key = 0; key < 20; ++key)
+    {
+      EXPECT_EQ(key, cache[key]->read());
+    }
+
+    auto stats = cache.stats();
+    EXPECT_EQ(100, stats.queueSize);
+    EXPECT_EQ(100, stats.mapSize);
+  }
+
+  TEST(CacheTests, Visit)
+  {
+    std::unordered_map<int, std::string> values;
+
+    Cache<int, std::string> cache(
+      2, 
+      [&values] (const int& key, const std::string& value) noexcept
+      {
+        values[key] = value;
+      }
+    );
+
+    std::string value;
+    auto read = [&value] (Item<std::string>& item) { value = item.read(); };
+
+    EXPECT_FALSE(cache.visit(1, read));
+    EXPECT_EQ(0, cache.stats().queueSize);
+
+    cache.visit_or_create(1, [] (Item<std::string>& item) { item.update("a"); });
+    EXPECT_EQ(2u, cache.visit_or_create(2, [] (Item<std::string>& item) { item.update("bc"); return item.read().size(); }));
+
+    EXPECT_TRUE(cache.visit(1, read));
+    EXPECT_EQ("a", value);
+
+    // visiting touches the item, so 2 is evicted rather than 1
+    cache.visit_or_create(3, [] (Item<std::string>&) {});
+    EXPECT_EQ(1, values.size());
+    EXPECT_EQ("bc", values[2]);
+    EXPECT_FALSE(cache.visit(2, read));
+
+    auto stats = cache.stats();
+    EXPECT_EQ(1, stats.hits);
+    EXPECT_EQ(5, stats.misses);
+
+    EXPECT_ANY_THROW(cache.visit(1, [] (Item<std::string>&) { throw std::runtime_error("visitor"); }));
+    EXPECT_TRUE(cache.visit(1, read));
+  }
+
+  TEST(CacheTests, VisitMT)
+  {
+    Cache<int, int> cache(100, [] (const int& key, const int& value) noexcept { EXPECT_EQ(key, value); }, false, 0, { 4, false });
+
+    std::vector<std::future<void>> futures;
+
+    for (int i = 0; i < 4; ++i)
+    {
+      futures.push_back(std::async(std::launch::async, [&cache, i]
+      {
+        for (int j = 0; j < 10000; ++j)
+        {
+          auto key = (j * 3 + i) % 400;
+
+          if (j % 2 == 0)
+          {
+            cache.visit_or_create(key, [key] (Item<int>& item) { item.update(key); });
+          }
+          else
+          {
+            cache.visit(key, [key] (Item<int>& item)
+            {
+              auto value = item.read();
+              EXPECT_TRUE(value == 0 || value == key);
+            });
+          }
+        }
+      }));
+    }
+
+    for (auto& future : futures)
+    {
+      future.get();
+    }
+
+    EXPECT_EQ(100, cache.stats().queueSize);
+  }
+
+  TEST(CacheTests, Epoch)
+  {
+    std::unordered_map<int, std::string> values;
+
+    Cache<int, std::string> plain(2, [] (const int&, const std::string&) noexcept {});
+    EXPECT_ANY_THROW(plain.pin());
+    EXPECT_EQ(0, plain.reclaim());
+
+    EvictionOptions eviction;
+    eviction.epochReclamation = true;
+
+    Cache<int, std::string> cache(
+      2, 
+      [&values] (const int& key, const std::string& value) noexcept
+      {
+        values[key] = value;
+      },
+      false,
+      "",
+      ShardingOptions(),
+      eviction
+    );
+
+    EXPECT_ANY_THROW(cache.borrow(1, Cache<int, std::string>::Guard()));
+
+    {
+      auto guard = cache.pin();
+
+      auto item = cache.borrow(1, guard);
+      ASSERT_NE(nullptr, item);
+      item->update("a");
+      cache.borrow(2, guard)->update("b");
+
+      // the evicted item reaches the update hook right away, and stays usable under the guard
+      cache.borrow(3, guard);
+      EXPECT_FALSE(cache.visit(1, [] (Item<std::string>&) {}));
+      EXPECT_EQ(1, cache.stats().retiredSize);
+      EXPECT_EQ(0, cache.reclaim());
+      EXPECT_EQ("a", values[1]);
+      EXPECT_EQ("a", item->read());
+
+      // a write after the eviction reaches the update hook on release
+      item->update("z");
+
+      EXPECT_TRUE(cache.mark_absent(4));
+      EXPECT_EQ(nullptr, cache.borrow(4, guard, true));
+      EXPECT_EQ("b", cache.borrow(2, guard)->read());
+    }
+
+    EXPECT_EQ("a", values[1]);
+    EXPECT_EQ(1, cache.reclaim());
+    EXPECT_EQ("z", values[1]);
+    EXPECT_EQ(0, cache.stats().retiredSize);
+
+    // entries leaving the cache by any path are retired
+    std::vector<std::pair<int, std::string>> items({ { 5, "e" }, { 6, "f" } });
+    EXPECT_EQ(2, cache.insert(items.begin(), items.end()));
+    EXPECT_EQ(2, cache.stats().retiredSize);
+    EXPECT_EQ("b", values[2]);
+    cache.resize(1);
+    EXPECT_EQ(3, cache.stats().retiredSize);
+
+    EXPECT_EQ(3, cache.reclaim());
+    EXPECT_EQ(2, values.size());
+  }
+
+  TEST(CacheTests, EpochMT)
+  {
+    EvictionOptions eviction;
+    eviction.epochReclamation = true;
+
+    std::atomic<size_t> hooked(0);
+
+    auto cache = make_cache<int, int>(
+      100, 
+      [&hooked] (const int& key, const int& value) noexcept
+      {
+        EXPECT_EQ(key, value);
+        ++hooked;
+      },
+      false,
+      0,
+      { 4, false },
+      eviction
+    );
+
+    std::vector<std::future<void>> futures;
+
+    for (int i = 0; i < 4; ++i)
+    {
+      futures.push_back(std::async(std::launch::async, [&cache, i]
+      {
+        for (int j = 0; j < 10000; ++j)
+        {
+          auto key = (j * 7 + i) % 400;
+
+          auto guard = cache->pin();
+          auto item = cache->borrow(key, guard);
+
+          if (j % 2 == 0)
+          {
+            item->update(key);
+          }
+          else
+          {
+            auto value = item->read();
+            EXPECT_TRUE(value == 0 || value == key);
+          }
+        }
+      }));
+    }
+
+    for (auto& future : futures)
+    {
+      future.get();
+    }
+
+    cache->reclaim();
+    EXPECT_EQ(0, cache->stats().retiredSize);
+    EXPECT_EQ(100, cache->stats().queueSize);
+
+    cache.reset();
+    EXPECT_LT(0, hooked.load());
+  }
+
+  TEST(CacheTests, Erase)
+  {
+    std::unordered_map<int, std::string> values;
+    std::vector<UpdateReason> reasons;
+
+    Cache<int, std::string> cache(
+      10, 
+      [&values, &reasons] (const int& key, const std::string& value, UpdateReason reason) noexcept
+      {
+        values[key] = value;
+        reasons.push_back(reason);
+      },
+      false,
+      "",
+      ShardingOptions(),
+      { .5 }
+    );
+
+    cache[1]->update("a");
+    cache[2]->update("b");
+    cache[3];
+    cache[3];
+    auto handle = cache.lookup(2);
+
+    EXPECT_FALSE(cache.erase(4));
+    EXPECT_TRUE(cache.erase(1));
+    EXPECT_FALSE(cache.erase(1));
+    EXPECT_EQ("a", values[1]);
+    EXPECT_EQ(std::vector<UpdateReason>({ UpdateReason::Erased }), reasons);
+
+    // modifications are dropped without flushing, and handles see the item leave
+    EXPECT_TRUE(cache.erase(2, false));
+    EXPECT_FALSE(handle.linked());
+    EXPECT_EQ("b", handle.item()->read());
+    EXPECT_EQ(0, values.count(2));
+
+    // the protected item 3 is erased as well
+    EXPECT_TRUE(cache.erase(3));
+    EXPECT_EQ(0, cache.stats().queueSize);
+    EXPECT_EQ(0, cache.stats().mapSize);
+
+    // erasing ends a known absence
+    EXPECT_TRUE(cache.mark_absent(5));
+    EXPECT_FALSE(cache.erase(5));
+    EXPECT_FALSE(cache.absent(5));
+
+    cache[1];
+    EXPECT_EQ("", cache[1]->read());
+    EXPECT_EQ(1, cache.stats().queueSize);
+  }
+
+  TEST(CacheTests, EraseIf)
+  {
+    std::unordered_map<int, int> values;
+
+    Cache<int, int> cache(
+      2000, 
+      [&values] (const int& key, const int& value) noexcept
+      {
+        values[key] = value;
+      },
+      false,
+      0,
+      { 4, false }
+    );
+
+    for (int key = 0; key < 1000; ++key)
+    {
+      cache[key]->update(key);
+    }
+
+    // odd keys without flushing, then multiples of 10 with flushing
+    EXPECT_EQ(500, cache.erase_if([] (const int& key, const Item<int>&) { return key % 2 == 1; }, false));
+    EXPECT_EQ(100, cache.erase_if([] (const int&, const Item<int>& item) { return item.read() % 10 == 0; }));
+    EXPECT_EQ(0, cache.erase_if([] (const int& key, const Item<int>&) { return key % 2 == 1; }));
+
+    EXPECT_EQ(100, values.size());
+    EXPECT_EQ(20, values[20]);
+    EXPECT_EQ(400, cache.stats().queueSize);
+    EXPECT_TRUE(cache.visit(2, [] (Item<int>& item) { EXPECT_EQ(2, item.read()); }));
+    EXPECT_FALSE(cache.visit(3, [] (Item<int>&) {}));
+
+    EXPECT_ANY_THROW(cache.erase_if([] (const int&, const Item<int>&) -> bool { throw std::runtime_error("predicate"); }));
+    EXPECT_EQ(400, cache.stats().queueSize);
+
+    EXPECT_EQ(400, cache.clear(false));
+    EXPECT_EQ(100, values.size());
+    EXPECT_EQ(0, cache.stats().queueSize);
+    EXPECT_EQ(0, cache.stats().mapSize);
+    EXPECT_EQ(0, cache.clear());
+
+    // the cleared cache is filled again
+    for (int key = 0; key < 1000; ++key)
+    {
+      cache[key]->update(key);
+    }
+
+    EXPECT_EQ(1000, cache.stats().queueSize);
+    EXPECT_EQ(1000, cache.clear());
+    EXPECT_EQ(1000, values.size());
+  }
+
+  TEST(CacheTests, EraseMT)
+  {
+    EvictionOptions eviction;
+    eviction.protectedRatio = .5;
+    eviction.epochReclamation = true;
+
+    auto cache = make_cache<int, int>(
+      100, 
+      [] (const int& key, const int& value) noexcept { EXPECT_EQ(key, value); }, 
+      false, 
+      0, 
+      { 4, false }, 
+      eviction
+    );
+
+    std::atomic<bool> stop(false);
+    std::vector<std::future<void>> futures;
+
+    for (int i = 0; i < 4; ++i)
+    {
+      futures.push_back(std::async(std::launch::async, [&cache, &stop, i]
+      {
+        while (!stop.load())
+        {
+          for (int j = 0; j < 100; ++j)
+          {
+            auto key = (j * 3 + i) % 200;
+
+            auto guard = cache->pin();
+            auto item = cache->borrow(key, guard);
+
+            if (j % 2 == 0)
+            {
+              item->update(key);
+            }
+            else
+            {
+              auto value = item->read();
+              EXPECT_TRUE(value == 0 || value == key);
+            }
+          }
+        }
+      }));
+    }
+
+    for (int i = 0; i < 2000; ++i)
+    {
+      if (i % 3 == 0)
+      {
+        cache->clear(i % 2 == 0);
+      }
+      else if (i % 3 == 1)
+      {
+        cache->erase_if([i] (const int& key, const Item<int>&) { return key % 7 == i % 7; });
+      }
+      else
+      {
+        cache->erase(i);
+      }
+    }
+
+    stop.store(true);
+
+    for (auto& future : futures)
+    {
+      future.get();
+    }
+
+    auto stats = cache->stats();
+    EXPECT_EQ(stats.queueSize, stats.mapSize);
+    EXPECT_GE(100, stats.queueSize);
+  }
+
+  TEST(CacheTests, EraseIfWhileLookedUpMT)
+  {
+    Cache<int, int> cache(
+      1000, 
+      [] (const int&, const int&) noexcept
+      {
+      }
+    );
+
+    for (int i = 0; i < 1000; ++i)
+    {
+      cache[i]->update(i);
+    }
+
+    std::atomic<bool> stop(false);
+
+    auto lookups = std::async(std::launch::async, [&cache, &stop]
+    {
+      for (int i = 0; !stop.load(); i = (i + 13) % 1000)
+      {
+        cache.visit(i, [] (Item<int>&) {});
+      }
+    });
+
+    std::vector<int> tested;
+    auto erased = cache.erase_if([&tested] (const int& key, const Item<int>&)
+    {
+      tested.push_back(key);
+      return key % 2 == 0;
+    });
+
+    stop.store(true);
+    lookups.get();
+
+    // every item is tested once, however lookups reorder the queue between chunks
+    std::sort(tested.begin(), tested.end());
+    EXPECT_EQ(1000, tested.size());
+    EXPECT_EQ(tested.end(), std::unique(tested.begin(), tested.end()));
+    EXPECT_EQ(500, erased);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+      EXPECT_EQ(i % 2 != 0, cache.visit(i, [] (Item<int>&) {}));
+    }
+  }
+
 }
@@ -0,0 +1,272 @@
+#include <cache/coroutine.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+  using namespace cache;
+
+  // coroutine running until its first suspension on the calling thread, then on the threads resuming it
+  struct Detached
+  {
+    struct promise_type
+    {
+      Detached get_return_object() noexcept { return {}; }
+      std::suspend_never initial_suspend() noexcept { return {}; }
+      std::suspend_never final_suspend() noexcept { return {}; }
+      void return_void() noexcept {}
+      void unhandled_exception() noexcept { std::terminate(); }
+    };
+  };
+
+  class ThreadPool
+  {
+  public:
+    explicit ThreadPool(size_t threadCount)
+      : m_stop(false)
+    {
+      for (size_t i = 0; i < threadCount; ++i)
+      {
+        m_threads.emplace_back([this]
+        {
+          for (;;)
+          {
+            std::function<void()> task;
+
+            {
+              std::unique_lock<std::mutex> lock(m_mutex);
+              m_condition.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+
+              if (m_tasks.empty())
+              {
+                return;
+              }
+
+              task = std::move(m_tasks.front());
+              m_tasks.pop_front();
+            }
+
+            task();
+          }
+        });
+      }
+    }
+
+    ~ThreadPool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+      }
+
+      m_condition.notify_all();
+
+      for (auto& thread : m_threads)
+      {
+        thread.join();
+      }
+    }
+
+    void post(std::function<void()> task)
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+      }
+
+      m_condition.notify_one();
+    }
+
+  private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::function<void()>> m_tasks;
+    bool m_stop;
+    std::vector<std::thread> m_threads;
+  };
+
+  TEST(CoroutineTests, Get)
+  {
+    Cache<int, std::string> cache(10, [] (const int&, const std::string&) noexcept {}, false, "NODATA");
+
+    std::vector<std::function<void()>> posted;
+    auto executor = [&posted] (std::function<void()> task) { posted.push_back(std::move(task)); };
+
+    std::vector<int> loads;
+    auto loader = [&loads] (const int& key)
+    {
+      loads.push_back(key);
+
+      if (key < 0)
+      {
+        throw std::runtime_error("loader");
+      }
+
+      if (key == 3)
+      {
+        return std::string("NODATA");
+      }
+
+      return std::to_string(key);
+    };
+
+    std::vector<std::string> results;
+
+    auto stream = [&] (int key) -> Detached
+    {
+      try
+      {
+        auto item = co_await co_get(cache, key, loader, executor);
+        results.push_back(item ? item->read() : "absent");
+      }
+      catch (const std::exception&)
+      {
+        results.push_back("error");
+      }
+    };
+
+    // a miss suspends until the executor runs the load
+    stream(1);
+    EXPECT_TRUE(results.empty());
+    ASSERT_EQ(1, posted.size());
+    posted.front()();
+    EXPECT_EQ(std::vector<std::string>({ "1" }), results);
+
+    // a hit does not suspend
+    stream(1);
+    EXPECT_EQ(1, posted.size());
+    EXPECT_EQ(std::vector<int>({ 1 }), loads);
+    EXPECT_EQ("1", results.back());
+
+    // nor does a hit on a key whose loaded value equals the default one
+    stream(3);
+    ASSERT_EQ(2, posted.size());
+    posted.back()();
+    stream(3);
+    EXPECT_EQ(2, posted.size());
+    EXPECT_EQ(std::vector<int>({ 1, 3 }), loads);
+    EXPECT_EQ("NODATA", results.back());
+
+    // neither does a known absence
+    EXPECT_TRUE(cache.mark_absent(2));
+    stream(2);
+    EXPECT_EQ("absent", results.back());
+
+    // exceptions of the loader reach the coroutine
+    stream(-1);
+    ASSERT_EQ(3, posted.size());
+    posted.back()();
+    EXPECT_EQ("error", results.back());
+    EXPECT_EQ("NODATA", cache[-1]->read());
+  }
+
+  TEST(CoroutineTests, ExecutorThrows)
+  {
+    Cache<int, std::string> cache(10, [] (const int&, const std::string&) noexcept {}, false, "NODATA");
+
+    auto loader = [] (const int& key) { return std::to_string(key); };
+
+    std::vector<std::string> results;
+
+    auto stream = [&] (int key, bool runFirst) -> Detached
+    {
+      try
+      {
+        auto executor = [runFirst] (std::function<void()> task)
+        {
+          if (runFirst)
+          {
+            task();
+          }
+
+          throw std::runtime_error("executor");
+        };
+
+        auto item = co_await co_get(cache, key, loader, executor);
+        results.push_back(item->read());
+      }
+      catch (const std::exception&)
+      {
+        results.push_back("error");
+      }
+    };
+
+    // a load not run by the executor does not resume the coroutine, which continues with the exception
+    stream(1, false);
+    EXPECT_EQ(std::vector<std::string>({ "error" }), results);
+    EXPECT_FALSE(cache[1]->loaded());
+
+    // a load run before the executor throws resumes the coroutine once, with the loaded value
+    stream(2, true);
+    EXPECT_EQ(std::vector<std::string>({ "error", "2" }), results);
+  }
+
+  TEST(CoroutineTests, StreamsMT)
+  {
+    const int streamCount = 1000;
+    const int keyCount = 20;
+
+    Cache<int, int> cache(100, [] (const int&, const int&) noexcept {}, false, -1, { 4, false });
+    ThreadPool pool(4);
+
+    std::atomic<int> loads(0);
+    std::atomic<int> completed(0);
+    std::atomic<int> errors(0);
+
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    auto stream = [&] (int first) -> Detached
+    {
+      for (int i = 0; i < keyCount; ++i)
+      {
+        auto key = (first + i * 7) % 200;
+
+        auto item = co_await co_get(
+          cache, 
+          key, 
+          [&loads] (const int& key) { ++loads; return 2 * key; },
+          [&pool] (std::function<void()> task) { pool.post(std::move(task)); }
+        );
+
+        if (item->read() != 2 * key)
+        {
+          ++errors;
+        }
+      }
+
+      if (++completed == streamCount)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        condition.notify_one();
+      }
+    };
+
+    // many more streams than threads, each suspended while its loads are in flight
+    for (int i = 0; i < streamCount; ++i)
+    {
+      stream(i);
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      condition.wait(lock, [&completed] { return completed.load() == streamCount; });
+    }
+
+    EXPECT_EQ(0, errors.load());
+    EXPECT_LT(0, loads.load());
+    EXPECT_GT(streamCount * keyCount, loads.load());
+  }
+
+}
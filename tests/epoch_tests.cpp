@@ -0,0 +1,181 @@
+#include <utility/epoch.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+  using namespace utility;
+
+  TEST(EpochTests, Retire)
+  {
+    EpochDomain domain;
+
+    domain.retire(nullptr);
+    EXPECT_EQ(0u, domain.retired());
+
+    std::weak_ptr<int> retired;
+    {
+      auto object = std::make_shared<int>(1);
+      retired = object;
+      domain.retire(std::move(object));
+    }
+
+    EXPECT_EQ(1u, domain.retired());
+    EXPECT_FALSE(retired.expired());
+
+    EXPECT_EQ(1u, domain.collect());
+    EXPECT_EQ(0u, domain.retired());
+    EXPECT_TRUE(retired.expired());
+
+    // objects left are released with the domain
+    {
+      EpochDomain other;
+      auto object = std::make_shared<int>(2);
+      retired = object;
+      other.retire(std::move(object));
+    }
+
+    EXPECT_TRUE(retired.expired());
+  }
+
+  TEST(EpochTests, Pin)
+  {
+    EpochDomain domain;
+    EpochDomain other;
+
+    EpochDomain::Guard empty;
+    EXPECT_FALSE(empty.pins(domain));
+
+    auto guard = domain.pin();
+    EXPECT_TRUE(guard.pins(domain));
+    EXPECT_FALSE(guard.pins(other));
+
+    auto nested = domain.pin();
+
+    std::weak_ptr<int> retired;
+    {
+      auto object = std::make_shared<int>(1);
+      retired = object;
+      domain.retire(std::move(object));
+    }
+
+    // retired objects are kept while a reader pinned before their retirement is pinned
+    for (int i = 0; i < 10; ++i)
+    {
+      domain.collect();
+    }
+
+    EXPECT_FALSE(retired.expired());
+
+    // nested pins and moved guards keep the epoch pinned as well
+    auto moved = std::move(guard);
+    EXPECT_FALSE(guard.pins(domain));
+
+    guard = std::move(empty);
+    moved = EpochDomain::Guard();
+    domain.collect();
+    EXPECT_FALSE(retired.expired());
+
+    nested = EpochDomain::Guard();
+    EXPECT_EQ(1u, domain.collect());
+    EXPECT_TRUE(retired.expired());
+  }
+
+  TEST(EpochTests, ConcurrentMT)
+  {
+    struct Object
+    {
+      explicit Object(int value) : value(value) {}
+      ~Object() { value = -1; }
+
+      int value;
+    };
+
+    EpochDomain domain;
+
+    auto live = std::make_shared<Object>(0);
+    std::atomic<Object*> current(live.get());
+
+    std::atomic<bool> stop(false);
+    std::vector<std::future<void>> readers;
+
+    for (int i = 0; i < 4; ++i)
+    {
+      readers.push_back(std::async(std::launch::async, [&domain, &current, &stop]
+      {
+        int last = 0;
+
+        while (!stop.load())
+        {
+          auto guard = domain.pin();
+          auto value = current.load()->value;
+
+          // objects are replaced with increasing values, and are never observed released
+          EXPECT_LE(last, value);
+          last = value;
+        }
+      }));
+    }
+
+    // replaced objects are retired while readers may still be using them
+    for (int i = 1; i <= 20000; ++i)
+    {
+      auto next = std::make_shared<Object>(i);
+      current.store(next.get());
+      domain.retire(std::move(live));
+      live = std::move(next);
+    }
+
+    stop.store(true);
+
+    for (auto& reader : readers)
+    {
+      reader.get();
+    }
+
+    EXPECT_EQ(20000, current.load()->value);
+    EXPECT_GT(20000u, domain.retired());
+  }
+
+  TEST(EpochTests, RetireMT)
+  {
+    EpochDomain domain;
+    std::vector<std::weak_ptr<int>> retired(4 * 5000);
+    std::vector<std::future<void>> writers;
+
+    for (int i = 0; i < 4; ++i)
+    {
+      writers.push_back(std::async(std::launch::async, [&domain, &retired, i]
+      {
+        for (int j = 0; j < 5000; ++j)
+        {
+          auto guard = domain.pin();
+          auto object = std::make_shared<int>(j);
+          retired[i * 5000 + j] = object;
+          domain.retire(std::move(object));
+        }
+      }));
+    }
+
+    for (auto& writer : writers)
+    {
+      writer.get();
+    }
+
+    // objects retired by every thread are released once no reader is pinned
+    domain.collect();
+    EXPECT_EQ(0u, domain.retired());
+
+    for (const auto& object : retired)
+    {
+      EXPECT_TRUE(object.expired());
+    }
+  }
+
+}
@@ -0,0 +1,63 @@
+#include <cache/fixed_string.h>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace
+{
+
+  using namespace cache;
+
+  TEST(FixedStringTests, Construction)
+  {
+    static_assert(std::is_trivially_copyable<FixedString<23>>::value, "FixedString must be trivially copyable");
+    static_assert(sizeof(FixedString<23>) == 24, "FixedString must only store its characters and size");
+
+    FixedString<23> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(0u, empty.size());
+    EXPECT_EQ("", empty.str());
+
+    FixedString<23> fromLiteral("NODATA");
+    EXPECT_EQ(6u, fromLiteral.size());
+    EXPECT_EQ("NODATA", fromLiteral.str());
+
+    std::string value(23, 'x');
+    FixedString<23> full(value);
+    EXPECT_EQ(value, full.str());
+    EXPECT_EQ(23u, FixedString<23>::capacity());
+
+    EXPECT_ANY_THROW(FixedString<23>(std::string(24, 'x')));
+    EXPECT_ANY_THROW(FixedString<3>("abcd"));
+  }
+
+  TEST(FixedStringTests, Comparison)
+  {
+    EXPECT_EQ(FixedString<8>("abc"), FixedString<8>(std::string("abc")));
+    EXPECT_NE(FixedString<8>("abc"), FixedString<8>("abcd"));
+    EXPECT_NE(FixedString<8>("abc"), FixedString<8>("abd"));
+    EXPECT_NE(FixedString<8>(), FixedString<8>("a"));
+
+    // assignment of a shorter value leaves no trace of the longer one
+    FixedString<8> value("abcdef");
+    value = FixedString<8>("ab");
+    EXPECT_EQ(FixedString<8>("ab"), value);
+    EXPECT_EQ("ab", value.str());
+  }
+
+  TEST(FixedStringTests, InlineBytes)
+  {
+    const unsigned char bytes[] = { 0, 255, 0, 7 };
+
+    InlineBytes<16> value(bytes, sizeof(bytes));
+    EXPECT_EQ(4u, value.size());
+    EXPECT_EQ(std::string("\0\xff\0\x07", 4), value.str());
+    EXPECT_EQ(0, std::memcmp(bytes, value.data(), sizeof(bytes)));
+    EXPECT_EQ(InlineBytes<16>(bytes, sizeof(bytes)), value);
+    EXPECT_NE(InlineBytes<16>(bytes, 3), value);
+  }
+
+}
@@ -0,0 +1,151 @@
+#include <cache/cache.h>
+#include <cache/front_cache.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+  using namespace cache;
+
+  using TestCache = Cache<int, std::string>;
+
+  TEST(FrontCacheTests, Invalid)
+  {
+    TestCache cache(10, [] (const int&, const std::string&) noexcept {});
+
+    EXPECT_ANY_THROW((FrontCache<int, std::string>(cache, 0)));
+    EXPECT_ANY_THROW((FrontCache<int, std::string>(cache, 8, 0)));
+  }
+
+  TEST(FrontCacheTests, Handle)
+  {
+    TestCache cache(1, [] (const int&, const std::string&) noexcept {});
+
+    TestCache::Handle empty;
+    EXPECT_FALSE(empty.linked());
+    EXPECT_EQ(nullptr, empty.item());
+
+    auto handle = cache.lookup(1);
+    EXPECT_TRUE(handle.linked());
+    EXPECT_EQ(handle.item(), cache[1]);
+
+    cache[2];
+    EXPECT_FALSE(handle.linked());
+    EXPECT_NE(handle.item(), cache[1]);
+
+    cache.mark_absent(3);
+    EXPECT_EQ(nullptr, cache.lookup(3, true).item());
+    EXPECT_EQ(nullptr, make_front_cache(cache)->get(3));
+    EXPECT_TRUE(cache.absent(3));
+  }
+
+  TEST(FrontCacheTests, HitsAndEviction)
+  {
+    std::unordered_map<int, std::string> values;
+
+    TestCache cache(
+      2, 
+      [&values] (const int& key, const std::string& value) noexcept
+      {
+        values[key] = value;
+      }
+    );
+
+    auto front = make_front_cache(cache, 8, 100);
+
+    front->operator[](1)->update("a");
+    EXPECT_EQ("a", (*front)[1]->read());
+    EXPECT_EQ("a", (*front)[1]->read());
+    EXPECT_EQ(2, front->hits());
+    EXPECT_EQ(1, front->misses());
+    EXPECT_EQ(1, cache.stats().misses);
+    EXPECT_EQ(0, cache.stats().hits);
+
+    // key 1 is evicted from the cache, but kept alive by the front cache until it is looked up again
+    cache[2];
+    cache[3];
+    EXPECT_EQ(1, cache.stats().evictions);
+    EXPECT_TRUE(values.empty());
+
+    EXPECT_EQ("", (*front)[1]->read());
+    EXPECT_EQ(2, front->misses());
+    EXPECT_EQ("a", values[1]);
+
+    (*front)[1]->update("b");
+    front->clear();
+    cache.resize(1);
+    cache[4];
+    EXPECT_EQ("b", values[1]);
+  }
+
+  TEST(FrontCacheTests, Promote)
+  {
+    TestCache cache(2, [] (const int&, const std::string&) noexcept {});
+
+    auto front = make_front_cache(cache, 8, 4);
+
+    for (int i = 0; i < 8; ++i)
+    {
+      (*front)[1];
+    }
+
+    EXPECT_EQ(6, front->hits());
+    EXPECT_EQ(2, front->misses());
+    EXPECT_EQ(1, cache.stats().hits);
+
+    // key 1 was refreshed in the cache, so key 2 is evicted first
+    cache[2];
+    (*front)[1];
+    cache[3];
+    EXPECT_EQ(1, cache.stats().evictions);
+    EXPECT_EQ(2, cache.stats().hits);
+
+    cache[1];
+    EXPECT_EQ(3, cache.stats().hits);
+  }
+
+  TEST(FrontCacheTests, ConcurrentMT)
+  {
+    Cache<int, int> cache(64, [] (const int&, const int&) noexcept {}, false, 0, { 4, false });
+
+    std::vector<std::future<void>> futures;
+
+    for (int i = 0; i < 4; ++i)
+    {
+      futures.push_back(std::async(std::launch::async, [&cache, i]
+      {
+        auto front = make_front_cache(cache, 16);
+
+        for (int j = 0; j < 20000; ++j)
+        {
+          auto key = (j % 7 == 0) ? 100 + j % 500 : i * 4 + j % 4;
+
+          const auto& ptr = (*front)[key];
+
+          // items evicted in between are created anew with the default value
+          auto value = ptr->read();
+          EXPECT_TRUE(value == 0 || value == key);
+
+          ptr->update(key);
+        }
+
+        EXPECT_LT(0, front->hits());
+      }));
+    }
+
+    for (auto& future : futures)
+    {
+      future.get();
+    }
+
+    EXPECT_EQ(64, cache.stats().queueSize);
+  }
+
+}
@@ -0,0 +1,102 @@
+#include <cache/cache.h>
+#include <cache/hash.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+  using namespace cache;
+
+  struct ConstantHash
+  {
+    size_t operator()(const int&) const noexcept
+    {
+      return 42;
+    }
+  };
+
+  TEST(HashTests, Mix)
+  {
+    static_assert(mix_hash(1) != 1, "mix_hash must be computable at compile time");
+
+    Hash<size_t> hash;
+    EXPECT_EQ(hash(12345), hash(12345));
+    EXPECT_NE(hash(12345), hash(12346));
+    EXPECT_EQ(std::hash<std::string>()("abc"), Hash<std::string>()("abc"));
+
+    // keys with a power of 2 stride spread over buckets and shards alike
+    const size_t bucketCount = 64;
+    std::vector<size_t> buckets(bucketCount);
+    std::vector<size_t> upperBuckets(bucketCount);
+
+    for (size_t key = 0; key < 64 * 1024; key += 1024)
+    {
+      ++buckets[hash(key) % bucketCount];
+      ++upperBuckets[(hash(key) >> 58) % bucketCount];
+    }
+
+    EXPECT_GT(8, *std::max_element(buckets.begin(), buckets.end()));
+    EXPECT_GT(8, *std::max_element(upperBuckets.begin(), upperBuckets.end()));
+  }
+
+  TEST(HashTests, Sharded)
+  {
+    ShardingOptions sharding;
+    sharding.shardCount = 8;
+
+    Cache<size_t, int> cache(800, [] (const size_t&, const int&) noexcept {}, false, 0, sharding);
+
+    std::vector<size_t> shardSizes(sharding.shardCount);
+    for (size_t key = 0; key < 800 * 4096; key += 4096)
+    {
+      EXPECT_EQ(cache.shard_of(key), cache.shard_of(key));
+      ++shardSizes[cache.shard_of(key)];
+    }
+
+    for (auto size : shardSizes)
+    {
+      EXPECT_LT(50, size);
+      EXPECT_GT(150, size);
+    }
+  }
+
+  TEST(HashTests, Custom)
+  {
+    std::unordered_map<int, int> values;
+
+    // all keys collide, so they are only told apart by comparison
+    auto cache = make_cache<int, int, HashIndexPolicy, ConstantHash>(
+      10, 
+      [&values] (const int& key, const int& value) noexcept
+      {
+        values[key] = value;
+      }
+    );
+
+    for (int key = 0; key < 10; ++key)
+    {
+      (*cache)[key]->update(key + 1);
+    }
+
+    for (int key = 0; key < 10; ++key)
+    {
+      EXPECT_EQ(key + 1, (*cache)[key]->read());
+    }
+
+    for (int key = 10; key < 20; ++key)
+    {
+      (*cache)[key];
+    }
+
+    EXPECT_EQ(10, values.size());
+    EXPECT_EQ(5, values[4]);
+    EXPECT_EQ(10, cache->stats().mapSize);
+  }
+
+}
@@ -0,0 +1,100 @@
+#include <utility/histogram.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+  using namespace utility;
+
+  TEST(HistogramTests, Empty)
+  {
+    Histogram histogram;
+
+    EXPECT_EQ(0u, histogram.count());
+    EXPECT_EQ(0., histogram.mean());
+    EXPECT_EQ(0u, histogram.percentile(.99));
+  }
+
+  TEST(HistogramTests, BucketBounds)
+  {
+    for (uint64_t value = 0; value < 16; ++value)
+    {
+      EXPECT_EQ(value, Histogram::bucket_upper_bound(Histogram::bucket_index(value)));
+    }
+
+    for (uint64_t value : { 16ull, 17ull, 31ull, 32ull, 33ull, 1000ull, 123456789ull, ~0ull })
+    {
+      auto bound = Histogram::bucket_upper_bound(Histogram::bucket_index(value));
+
+      EXPECT_LE(value, bound);
+      EXPECT_LE(bound - value, value / 16);
+    }
+
+    EXPECT_EQ(Histogram::BucketCount - 1, Histogram::bucket_index(~0ull));
+  }
+
+  TEST(HistogramTests, Percentiles)
+  {
+    Histogram histogram;
+
+    for (uint64_t value = 1; value <= 1000; ++value)
+    {
+      histogram.record(value);
+    }
+
+    EXPECT_EQ(1000u, histogram.count());
+    EXPECT_EQ(500500u, histogram.sum());
+    EXPECT_DOUBLE_EQ(500.5, histogram.mean());
+    EXPECT_EQ(1u, histogram.percentile(0.));
+    EXPECT_NEAR(500., histogram.percentile(.5), 500. / 16);
+    EXPECT_NEAR(990., histogram.percentile(.99), 990. / 16);
+    EXPECT_EQ(Histogram::bucket_upper_bound(Histogram::bucket_index(1000)), histogram.percentile(1.));
+  }
+
+  TEST(HistogramTests, MergeMT)
+  {
+    const size_t threadCount = 4;
+    const uint64_t valueCount = 10000;
+
+    ConcurrentHistogram shared;
+    std::vector<Histogram> local(threadCount);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+      threads.emplace_back([&shared, &local, i, valueCount]
+      {
+        for (uint64_t value = 0; value < valueCount; ++value)
+        {
+          shared.record(value);
+          local[i].record(value);
+        }
+      });
+    }
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    Histogram merged;
+    for (const auto& histogram : local)
+    {
+      merged.merge(histogram);
+    }
+
+    EXPECT_EQ(threadCount * valueCount, shared.count());
+    EXPECT_EQ(shared.count(), merged.count());
+    EXPECT_EQ(shared.sum(), merged.sum());
+
+    for (size_t i = 0; i < Histogram::BucketCount; ++i)
+    {
+      EXPECT_EQ(shared.bucket(i), merged.bucket(i));
+    }
+  }
+
+}
@@ -0,0 +1,224 @@
+#include <cache/cache.h>
+#include <cache/dense_index.h>
+#include <cache/hash_index.h>
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+  using namespace cache;
+
+  template <typename IndexPolicy>
+  class IndexTests : public testing::Test
+  {
+  };
+
+  using IndexPolicies = testing::Types<HashIndexPolicy, DenseIndexPolicy>;
+  TYPED_TEST_CASE(IndexTests, IndexPolicies);
+
+  TYPED_TEST(IndexTests, Index)
+  {
+    using Index = typename TypeParam::template Index<int, int, std::allocator<int>>;
+
+    Index index(16, -1, std::allocator<int>());
+    Hash<int> hash;
+
+    EXPECT_EQ(nullptr, index.find(1, hash(1)));
+    EXPECT_FALSE(index.erase(1, hash(1)));
+
+    for (int key = 0; key < 5000; key += 3)
+    {
+      index.emplace(key, hash(key), 2 * key);
+    }
+
+    EXPECT_EQ(1667, index.size());
+    EXPECT_LT(0, index.memory());
+
+    ASSERT_NE(nullptr, index.find(2997, hash(2997)));
+    EXPECT_EQ(5994, *index.find(2997, hash(2997)));
+    EXPECT_EQ(nullptr, index.find(2998, hash(2998)));
+
+    *index.find(3, hash(3)) = 7;
+    EXPECT_EQ(7, *index.find(3, hash(3)));
+
+    for (int key = 0; key < 5000; key += 3)
+    {
+      EXPECT_TRUE(index.erase(key, hash(key)));
+    }
+
+    EXPECT_EQ(0, index.size());
+    EXPECT_EQ(nullptr, index.find(0, hash(0)));
+  }
+
+  TYPED_TEST(IndexTests, Cache)
+  {
+    std::unordered_map<size_t, std::string> values;
+
+    auto cache = make_cache<size_t, std::string, TypeParam>(
+      100,
+      [&values] (const size_t& key, const std::string& value) noexcept
+      {
+        values[key] = value;
+      }
+    );
+
+    for (size_t key = 1; key <= 300; ++key)
+    {
+      (*cache)[key]->update(std::to_string(key));
+    }
+
+    EXPECT_EQ(200, values.size());
+    EXPECT_EQ(100, cache->stats().mapSize);
+    EXPECT_EQ("250", (*cache)[250]->read());
+    EXPECT_EQ(100, cache->flush());
+    EXPECT_EQ(300, values.size());
+
+    EXPECT_TRUE(cache->mark_absent(250));
+    EXPECT_EQ(nullptr, cache->get(250));
+    EXPECT_EQ(99, cache->stats().mapSize);
+
+    cache->resize(10);
+    EXPECT_EQ(10, cache->stats().mapSize);
+    EXPECT_LT(0, cache->memory_usage());
+  }
+
+  TEST(IndexTests, HashCollisions)
+  {
+    HashIndex<std::string, int, std::allocator<int>> index(16, 0, std::allocator<int>());
+
+    // keys are told apart by value when their hashes are equal
+    index.emplace("a", 1, 1);
+    index.emplace("b", 1, 2);
+    index.emplace("c", 2, 3);
+
+    ASSERT_NE(nullptr, index.find("b", 1));
+    EXPECT_EQ(2, *index.find("b", 1));
+    EXPECT_EQ(nullptr, index.find("c", 1));
+
+    EXPECT_TRUE(index.erase("a", 1));
+    EXPECT_FALSE(index.erase("a", 1));
+    EXPECT_EQ(nullptr, index.find("a", 1));
+    EXPECT_EQ(2, *index.find("b", 1));
+    EXPECT_EQ(2, index.size());
+  }
+
+  TEST(IndexTests, DenseRange)
+  {
+    using Index = DenseIndex<long long, int, std::allocator<int>>;
+
+    Index index(16, 0, std::allocator<int>());
+
+    EXPECT_ANY_THROW(index.emplace(-1, 0, 1));
+    EXPECT_ANY_THROW(index.emplace(static_cast<long long>(Index::MaxKey) + 1, 0, 1));
+    EXPECT_EQ(nullptr, index.find(-1, 0));
+
+    // pages are allocated on first use and freed once empty
+    auto memory = index.memory();
+    index.emplace(1000000, 0, 1);
+    EXPECT_LT(memory, index.memory());
+    EXPECT_GE(memory + sizeof(int) * Index::PageSize + 1024 * sizeof(void*) * 2, index.memory());
+
+    memory = index.memory();
+    EXPECT_TRUE(index.erase(1000000, 0));
+    EXPECT_GT(memory, index.memory());
+  }
+
+  TEST(IndexTests, DenseOutOfRange)
+  {
+    Cache<long, int, UpdateHook<long, int>, DenseIndexPolicy> cache(
+      2,
+      [] (const long&, const int&) noexcept {},
+      false
+    );
+
+    EXPECT_ANY_THROW(cache[-1]);
+    EXPECT_ANY_THROW(cache[static_cast<long>(DenseIndex<long, int, std::allocator<int>>::MaxKey) + 1]);
+
+    std::vector<std::pair<long, int>> items({ { 1, 1 }, { -2, 2 } });
+    EXPECT_ANY_THROW(cache.insert(items.begin(), items.end()));
+
+    // rejected keys leave neither the queue nor the index behind
+    auto stats = cache.stats();
+    EXPECT_EQ(1, stats.queueSize);
+    EXPECT_EQ(1, stats.mapSize);
+
+    for (long key = 2; key < 10; ++key)
+    {
+      cache[key]->update(static_cast<int>(key));
+    }
+
+    stats = cache.stats();
+    EXPECT_EQ(2, stats.queueSize);
+    EXPECT_EQ(2, stats.mapSize);
+    EXPECT_EQ(9, cache[9]->read());
+  }
+
+  TEST(IndexTests, DenseMT)
+  {
+    Cache<size_t, size_t, UpdateHook<size_t, size_t>, DenseIndexPolicy> cache(
+      1000,
+      [] (const size_t& key, const size_t& value) noexcept
+      {
+        EXPECT_EQ(key, value);
+      },
+      false,
+      0,
+      { 4, false }
+    );
+
+    std::vector<std::future<void>> futures;
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+      futures.push_back(std::async(std::launch::async, [&cache, i]
+      {
+        for (size_t j = 0; j < 20000; ++j)
+        {
+          auto key = (j * 7 + i) % 30000;
+          cache[key]->update(key);
+        }
+      }));
+    }
+
+    for (auto& future : futures)
+    {
+      future.get();
+    }
+
+    auto stats = cache.stats();
+    EXPECT_EQ(1000, stats.queueSize);
+    EXPECT_EQ(1000, stats.mapSize);
+  }
+
+  TEST(IndexTests, DenseSharded)
+  {
+    Cache<size_t, size_t, UpdateHook<size_t, size_t>, DenseIndexPolicy> cache(
+      1000,
+      [] (const size_t&, const size_t&) noexcept {},
+      false,
+      0,
+      { 4, false }
+    );
+
+    using Index = DenseIndex<size_t, size_t, std::allocator<size_t>>;
+
+    // pages are not split between shards, so each is allocated once
+    std::vector<bool> used(cache.shard_count());
+    for (size_t key = 0; key < 64 * Index::PageSize; ++key)
+    {
+      EXPECT_EQ(cache.shard_of(key - key % Index::PageSize), cache.shard_of(key));
+      used[cache.shard_of(key)] = true;
+    }
+
+    EXPECT_EQ(std::vector<bool>(cache.shard_count(), true), used);
+  }
+
+}
@@ -1,9 +1,14 @@
+#include <cache/fixed_string.h>
 #include <cache/item_factory.h>
 #include <cache/item/lock_based_item.h>
 #include <cache/item/lock_free_item.h>
+#include <cache/item/rcu_item.h>
+#include <cache/item/seq_lock_item.h>
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <atomic>
 #include <type_traits>
 #include <vector>
 
@@ -56,6 +61,42 @@ namespace
     EXPECT_EQ("abc", item->read());
   }
 
+  TEST(ItemFactoryTests, Rcu)
+  {
+    ItemOptions options;
+    options.rcu = true;
+
+    std::string value = "abc";
+    auto item = make_item(value, options);
+    EXPECT_FALSE(nullptr == dynamic_cast<RcuItem<std::decay_t<decltype(value)>>*>(item.get()));
+    EXPECT_EQ("abc", item->read());
+
+    // lock-free items are kept
+    auto floatItem = make_item(1.f, options);
+    EXPECT_FALSE(nullptr == dynamic_cast<LockFreeItem<float>*>(floatItem.get()));
+  }
+
+  TEST(ItemFactoryTests, FixedString)
+  {
+    FixedString<23> value("abc");
+    auto item = make_item(value);
+    EXPECT_FALSE(nullptr == dynamic_cast<SeqLockItem<std::decay_t<decltype(value)>>*>(item.get()));
+    EXPECT_EQ(value, item->read());
+
+    auto writeHeavyItem = make_item(value, true);
+    EXPECT_FALSE(nullptr == dynamic_cast<LockBasedItem<std::decay_t<decltype(value)>>*>(writeHeavyItem.get()));
+
+    // other trivially copyable values keep read-write locks
+    using Triple = std::array<int64_t, 3>;
+    auto tripleItem = make_item(Triple { { 1, 2, 3 } });
+    EXPECT_FALSE(nullptr == dynamic_cast<LockBasedItem<Triple>*>(tripleItem.get()));
+
+    // short enough values are lock-free
+    auto shortItem = make_item(FixedString<7>("abc"));
+    EXPECT_EQ(std::atomic<FixedString<7>>().is_lock_free(), 
+      nullptr != dynamic_cast<LockFreeItem<FixedString<7>>*>(shortItem.get()));
+  }
+
   TEST(ItemFactoryTests, Vector)
   {
     auto value = std::vector<int> { 1, 3, 2 };
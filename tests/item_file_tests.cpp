@@ -3,6 +3,9 @@
 #include <gtest/gtest.h>
 
 #include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
 
 namespace
 {
@@ -123,4 +126,39 @@ namespace
     EXPECT_ANY_THROW(read_line(100));
   }
 
+  TEST_F(ItemFileFixture, WriteLines)
+  {
+    write_lines({ { 0, "50.1" }, { 5, "abc" }, { 11, "" } });
+
+    EXPECT_EQ("50.1", read_line(0));
+    EXPECT_EQ("22.5", read_line(1));
+    EXPECT_EQ("-33", read_line(2));
+    EXPECT_EQ("abc", read_line(5));
+    EXPECT_EQ("90.0", read_line(6));
+    EXPECT_EQ("", read_line(11));
+
+    write_lines({});
+    EXPECT_EQ("50.1", read_line(0));
+  }
+
+  TEST_F(ItemFileFixture, WriteLinesOutOfBound)
+  {
+    EXPECT_ANY_THROW(write_lines({ { 1, "abc" }, { 12, "abc" } }));
+
+    EXPECT_EQ("22.5", read_line(1));
+    EXPECT_EQ("10000.0", read_line(11));
+  }
+
+  TEST_F(ItemFileFixture, ReadLines)
+  {
+    EXPECT_EQ(std::vector<std::string>({ "-33", "", "75.2" }), read_lines(2, 3));
+    EXPECT_EQ(std::vector<std::string>({ "", "10000.0" }), read_lines(10, 100));
+    EXPECT_EQ(12, read_lines(0, std::numeric_limits<size_t>::max()).size());
+    EXPECT_TRUE(read_lines(12, 5).empty());
+
+    EXPECT_EQ(std::vector<std::string>({ "0", "", "", "100", "100", "10000.0" }), read_lines({ 0, 3, 3, 7, 7, 11, 12, 20 }));
+    EXPECT_TRUE(read_lines(std::vector<size_t>()).empty());
+    EXPECT_ANY_THROW(read_lines({ 5, 1 }));
+  }
+
 }
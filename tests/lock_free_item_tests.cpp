@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include <future>
+#include <stdexcept>
 #include <thread>
 #include <unordered_set>
 #include <vector>
@@ -48,6 +49,104 @@ namespace
     EXPECT_EQ(0.f, read());
   }
 
+  TEST_F(LockFreeItemFixture, ReadIntoST)
+  {
+    update(1.5f);
+
+    float value = 0.f;
+    read_into(value);
+    EXPECT_EQ(1.5f, value);
+
+    read_with([&value] (const float& current) { value = current + 1.f; });
+    EXPECT_EQ(2.5f, value);
+    EXPECT_EQ(1.5f, read());
+  }
+
+  TEST_F(LockFreeItemFixture, DirtyST)
+  {
+    EXPECT_FALSE(dirty());
+    EXPECT_FALSE(loaded());
+
+    // a loaded value equal to the default one still marks the item loaded
+    EXPECT_TRUE(populate(0.f, 0.f));
+    EXPECT_TRUE(loaded());
+    EXPECT_FALSE(dirty());
+
+    EXPECT_TRUE(populate(0.f, 1.f));
+    EXPECT_EQ(1.f, read());
+    EXPECT_FALSE(dirty());
+    EXPECT_FALSE(populate(0.f, 3.f));
+
+    EXPECT_FALSE(compare_exchange(0.f, 2.f));
+    EXPECT_EQ(1.f, read());
+    EXPECT_FALSE(dirty());
+
+    EXPECT_TRUE(compare_exchange(1.f, 2.f));
+    EXPECT_EQ(2.f, read());
+    EXPECT_TRUE(dirty());
+
+    EXPECT_TRUE(clean());
+    EXPECT_FALSE(dirty());
+    EXPECT_FALSE(clean());
+
+    update(3.f);
+    EXPECT_TRUE(dirty());
+  }
+
+  TEST_F(LockFreeItemFixture, FetchUpdateST)
+  {
+    EXPECT_EQ(0.f, fetch_update([] (const float& value) { return value + 2.f; }));
+    EXPECT_EQ(2.f, read());
+    EXPECT_TRUE(dirty());
+
+    EXPECT_TRUE(clean());
+    EXPECT_ANY_THROW(fetch_update([] (const float&) -> float { throw std::runtime_error("function"); }));
+    EXPECT_EQ(2.f, read());
+    EXPECT_FALSE(dirty());
+
+    EXPECT_EQ(2.f, fetch_add(.5f));
+    EXPECT_EQ(2.5f, read());
+    EXPECT_TRUE(dirty());
+  }
+
+  TEST_F(LockFreeItemFixture, FetchAddMT)
+  {
+    std::promise<void> promise;
+    auto signal = promise.get_future().share();
+
+    std::vector<std::thread> threads;
+    threads.reserve(20);
+    
+    for (int i = 0; i < 20; ++i)
+    {
+      threads.emplace_back([this, signal]
+      {
+        signal.wait();
+
+        for (int i = 0; i < 1000; ++i)
+        {
+          if (i % 2 == 0)
+          {
+            fetch_add(1.f);
+          }
+          else
+          {
+            fetch_update([] (const float& value) { return value + 1.f; });
+          }
+        }
+      });
+    }
+
+    promise.set_value();
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    EXPECT_EQ(20000.f, read());
+  }
+
   TEST_F(LockFreeItemFixture, SingleValueMT)
   {
     update(1.f);
@@ -180,4 +279,38 @@ namespace
     }
   }
 
+  TEST(LockFreeItemTests, IntegralFetchAddMT)
+  {
+    LockFreeItem<int> item(0);
+
+    std::vector<std::future<std::vector<int>>> futures;
+
+    for (int i = 0; i < 4; ++i)
+    {
+      futures.push_back(std::async(std::launch::async, [&item]
+      {
+        std::vector<int> previous;
+        for (int i = 0; i < 10000; ++i)
+        {
+          previous.push_back(item.fetch_add(1));
+        }
+
+        return previous;
+      }));
+    }
+
+    // every addition observes a distinct previous value
+    std::unordered_set<int> previous;
+    for (auto& future : futures)
+    {
+      for (auto value : future.get())
+      {
+        EXPECT_TRUE(previous.insert(value).second);
+      }
+    }
+
+    EXPECT_EQ(40000, item.read());
+    EXPECT_TRUE(item.dirty());
+  }
+
 }
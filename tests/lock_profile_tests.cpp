@@ -0,0 +1,96 @@
+#include <utility/lock_profile.h>
+#include <utility/shared_mutex_adaptor.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+
+  using namespace utility;
+
+  TEST(LockProfileTests, Registry)
+  {
+    auto& profile = lock_profile("registry_test");
+
+    EXPECT_EQ("registry_test", profile.name());
+    EXPECT_EQ(&profile, &lock_profile("registry_test"));
+    EXPECT_NE(&profile, &lock_profile("registry_test_other"));
+  }
+
+  TEST(LockProfileTests, Uncontended)
+  {
+    auto& profile = lock_profile("uncontended_test");
+    ProfilingMutex<std::mutex> mutex(profile);
+
+    for (int i = 0; i < 10; ++i)
+    {
+      std::lock_guard<ProfilingMutex<std::mutex>> lock(mutex);
+    }
+
+    EXPECT_EQ(10u, profile.uncontended());
+    EXPECT_EQ(0u, profile.contended());
+    EXPECT_EQ(10u, profile.wait_times().count());
+    EXPECT_EQ(10u, profile.hold_times().count());
+  }
+
+  TEST(LockProfileTests, ContendedMT)
+  {
+    auto& profile = lock_profile("contended_test");
+    ProfilingMutex<std::mutex> mutex(profile);
+
+    std::unique_lock<ProfilingMutex<std::mutex>> lock(mutex);
+
+    std::thread waiter([&mutex]
+    {
+      std::lock_guard<ProfilingMutex<std::mutex>> lock(mutex);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    lock.unlock();
+    waiter.join();
+
+    EXPECT_EQ(1u, profile.uncontended());
+    EXPECT_EQ(1u, profile.contended());
+    EXPECT_LE(uint64_t(10000000), profile.wait_times().percentile(1.));
+    EXPECT_LE(uint64_t(10000000), profile.hold_times().percentile(1.));
+  }
+
+  TEST(LockProfileTests, Shared)
+  {
+    auto& profile = lock_profile("shared_test");
+    ProfilingMutex<SharedMutex> mutex(profile);
+
+    {
+      std::shared_lock<ProfilingMutex<SharedMutex>> first(mutex);
+      std::shared_lock<ProfilingMutex<SharedMutex>> second(mutex);
+
+      EXPECT_FALSE(mutex.try_lock());
+    }
+
+    {
+      std::unique_lock<ProfilingMutex<SharedMutex>> lock(mutex);
+    }
+
+    EXPECT_EQ(3u, profile.uncontended());
+    EXPECT_EQ(1u, profile.hold_times().count());
+  }
+
+  TEST(LockProfileTests, Print)
+  {
+    ProfilingMutex<std::mutex> mutex(lock_profile("print_test"));
+    {
+      std::lock_guard<ProfilingMutex<std::mutex>> lock(mutex);
+    }
+
+    std::ostringstream stream;
+    print_lock_profiles(stream);
+
+    EXPECT_NE(std::string::npos, stream.str().find("Lock 'print_test': 1 acquisitions, 0 contended"));
+  }
+
+}
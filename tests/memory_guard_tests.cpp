@@ -0,0 +1,118 @@
+#include <cache/cache.h>
+#include <cache/memory_guard.h>
+
+#include <utility/resident_memory.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+
+  using namespace cache;
+
+  using TestCache = Cache<int, int>;
+
+  TEST(MemoryGuardTests, InvalidMarks)
+  {
+    TestCache cache(10, [] (const int&, const int&) noexcept {});
+    auto usage = [] { return size_t(0); };
+
+    EXPECT_ANY_THROW(MemoryGuard<TestCache>(cache, usage, 100, 0, std::chrono::milliseconds(10)));
+    EXPECT_ANY_THROW(MemoryGuard<TestCache>(cache, usage, 100, 200, std::chrono::milliseconds(10)));
+    EXPECT_ANY_THROW(MemoryGuard<TestCache>(cache, usage, 200, 100, std::chrono::milliseconds(0)));
+    EXPECT_ANY_THROW(MemoryGuard<TestCache>(cache, usage, 200, 100, std::chrono::milliseconds(10), 0));
+  }
+
+  TEST(MemoryGuardTests, ShrinkAndGrow)
+  {
+    TestCache cache(100, [] (const int&, const int&) noexcept {});
+    for (int key = 0; key < 100; ++key)
+    {
+      cache[key]->update(key);
+    }
+
+    size_t usage = 1000;
+    MemoryGuard<TestCache> guard(cache, [&usage] { return usage; }, 1000, 500, std::chrono::hours(1), 10);
+
+    EXPECT_EQ(100, guard.check());
+
+    usage = 2000;
+    EXPECT_EQ(25, guard.check());
+    EXPECT_EQ(25, cache.stats().capacity);
+    EXPECT_EQ(25, cache.stats().queueSize);
+
+    // usage which does not fall after a shrink (e.g. freed memory kept by the allocator) does not shrink it again
+    EXPECT_EQ(25, guard.check());
+    EXPECT_EQ(25, guard.check());
+
+    // growth of usage since the last shrink shrinks the cache in proportion
+    usage = 4000;
+    EXPECT_EQ(12, guard.check());
+    EXPECT_EQ(12, guard.check());
+
+    usage = 400;
+    EXPECT_EQ(14, guard.check());
+    EXPECT_EQ(16, guard.check());
+
+    usage = 100000;
+    EXPECT_EQ(10, guard.check());
+
+    usage = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+      guard.check();
+    }
+    EXPECT_EQ(100, cache.stats().capacity);
+  }
+
+  TEST(MemoryGuardTests, ShrinkSharded)
+  {
+    TestCache cache(100, [] (const int&, const int&) noexcept {}, false, 0, { 8, false });
+
+    size_t usage = 1000000;
+    MemoryGuard<TestCache> guard(cache, [&usage] { return usage; }, 1000, 500, std::chrono::hours(1));
+
+    // the cache cannot be smaller than its number of shards, whatever the minimal size
+    EXPECT_EQ(8, guard.check());
+    EXPECT_EQ(8, cache.stats().capacity);
+
+    usage *= 2;
+    EXPECT_EQ(8, guard.check());
+  }
+
+  TEST(MemoryGuardTests, AccountedMemoryMT)
+  {
+    TestCache cache(1000, [] (const int&, const int&) noexcept {});
+    for (int key = 0; key < 1000; ++key)
+    {
+      cache[key]->read();
+    }
+
+    auto full = cache.memory_usage();
+    EXPECT_LT(1000 * sizeof(int), full);
+
+    MemoryGuard<TestCache> guard(cache, [&cache] { return cache.memory_usage(); }, full / 2, full / 4, std::chrono::milliseconds(1));
+
+    for (int i = 0; i < 1000 && cache.memory_usage() > full / 2; ++i)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_GE(full / 2, cache.memory_usage());
+    EXPECT_GT(1000, cache.stats().capacity);
+  }
+
+  TEST(MemoryGuardTests, ResidentMemory)
+  {
+#if defined(__linux__)
+    EXPECT_LT(0, utility::resident_memory());
+#else
+    EXPECT_EQ(0, utility::resident_memory());
+#endif
+  }
+
+}
@@ -0,0 +1,108 @@
+#include <utility/numa.h>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <future>
+#include <list>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+  using namespace utility;
+
+  TEST(NumaTests, Topology)
+  {
+    EXPECT_LE(1u, numa_node_count());
+    EXPECT_GT(numa_node_count(), numa_current_node());
+    EXPECT_FALSE(numa_bind_thread(numa_node_count()));
+
+    std::thread([]
+    {
+      if (numa_bind_thread(0))
+      {
+        EXPECT_EQ(0u, numa_current_node());
+      }
+    }).join();
+  }
+
+  TEST(NumaTests, Allocate)
+  {
+    auto bytes = 3 * 4096 + 5;
+    auto ptr = static_cast<char*>(numa_allocate(bytes, numa_node_count() - 1));
+
+    ASSERT_NE(nullptr, ptr);
+    memset(ptr, 0xAB, bytes);
+    EXPECT_EQ('\xAB', ptr[bytes - 1]);
+
+    numa_free(ptr, bytes);
+  }
+
+  TEST(NumaTests, Arena)
+  {
+    NumaArena arena(0);
+    EXPECT_EQ(0u, arena.node());
+
+    std::set<void*> blocks;
+    for (size_t bytes : { 1, 8, 16, 17, 100, 1024, 1025, 100000 })
+    {
+      auto ptr = arena.allocate(bytes);
+
+      EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % 16);
+      EXPECT_TRUE(blocks.insert(ptr).second);
+      memset(ptr, 0, bytes);
+    }
+
+    // freed blocks are reused for the same size class
+    auto ptr = arena.allocate(40);
+    arena.deallocate(ptr, 40);
+    EXPECT_EQ(ptr, arena.allocate(33));
+  }
+
+  TEST(NumaTests, AllocatorMT)
+  {
+    auto arena = std::make_shared<NumaArena>(0);
+
+    NumaAllocator<int> allocator(arena);
+    NumaAllocator<double> other(allocator);
+
+    EXPECT_TRUE(allocator == other);
+    EXPECT_TRUE(NumaAllocator<int>() != allocator);
+
+    std::vector<std::future<size_t>> futures;
+
+    for (int i = 0; i < 4; ++i)
+    {
+      futures.push_back(std::async(std::launch::async, [allocator, i]
+      {
+        std::list<int, NumaAllocator<int>> values(allocator);
+
+        for (int j = 0; j < 10000; ++j)
+        {
+          values.push_back(i * j);
+          if (j % 3 == 0)
+          {
+            values.pop_front();
+          }
+        }
+
+        return values.size();
+      }));
+    }
+
+    // the containers keep the arena alive
+    arena.reset();
+
+    for (auto& future : futures)
+    {
+      EXPECT_EQ(6666u, future.get());
+    }
+
+    auto ptr = std::allocate_shared<std::vector<int>>(NumaAllocator<std::vector<int>>(), 3, 7);
+    EXPECT_EQ(std::vector<int>({ 7, 7, 7 }), *ptr);
+  }
+
+}
@@ -0,0 +1,52 @@
+#include <utility/per_thread_array.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+  using namespace utility;
+
+  TEST(PerThreadArrayTests, Layout)
+  {
+    PerThreadArray<std::vector<int>> array;
+
+    EXPECT_LE(std::thread::hardware_concurrency(), array.size());
+    EXPECT_EQ(0u, array.size() & (array.size() - 1));
+
+    for (size_t i = 0; i < array.size(); ++i)
+    {
+      // objects are value-initialized and start on cache lines of their own
+      EXPECT_TRUE(array[i].empty());
+      EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(&array[i]) % CacheLineSize);
+    }
+
+    EXPECT_EQ(&array[0], &array[array.size()]);
+  }
+
+  TEST(PerThreadArrayTests, LocalMT)
+  {
+    PerThreadArray<int> array;
+
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 4; ++i)
+    {
+      threads.emplace_back([&array]
+      {
+        EXPECT_EQ(&array[thread_index()], &array.local());
+        EXPECT_EQ(&array.local(), &array.local());
+      });
+    }
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+  }
+
+}
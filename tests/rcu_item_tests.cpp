@@ -0,0 +1,334 @@
+#include <cache/item/rcu_item.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+
+  using namespace cache;
+
+  class RcuItemFixture : protected RcuItem<float>
+                       , public ::testing::Test
+  {
+  public:
+    RcuItemFixture()
+      : RcuItem<float>(0.f)
+    {
+    }
+  };
+
+  TEST_F(RcuItemFixture, UpdateAndReadST)
+  {
+    EXPECT_EQ(0.f, read());
+    EXPECT_EQ(0.f, read());
+
+    update(1.f);
+    EXPECT_EQ(1.f, read());
+    EXPECT_EQ(1.f, read());
+
+    update(.5f);
+    EXPECT_EQ(.5f, read());
+    EXPECT_EQ(.5f, read());
+
+    update(61235.6f);
+    EXPECT_EQ(61235.6f, read());
+    EXPECT_EQ(61235.6f, read());
+
+    update(-61235.6f);
+    EXPECT_EQ(-61235.6f, read());
+    EXPECT_EQ(-61235.6f, read());
+
+    update(0.f);
+    EXPECT_EQ(0.f, read());
+    EXPECT_EQ(0.f, read());
+  }
+
+  TEST_F(RcuItemFixture, ReadIntoST)
+  {
+    update(1.5f);
+
+    float value = 0.f;
+    read_into(value);
+    EXPECT_EQ(1.5f, value);
+
+    read_with([&value] (const float& current) { value = current + 1.f; });
+    EXPECT_EQ(2.5f, value);
+    EXPECT_EQ(1.5f, read());
+  }
+
+  TEST_F(RcuItemFixture, DirtyST)
+  {
+    EXPECT_FALSE(dirty());
+    EXPECT_FALSE(loaded());
+
+    // a loaded value equal to the default one still marks the item loaded
+    EXPECT_TRUE(populate(0.f, 0.f));
+    EXPECT_TRUE(loaded());
+    EXPECT_FALSE(dirty());
+
+    EXPECT_TRUE(populate(0.f, 1.f));
+    EXPECT_EQ(1.f, read());
+    EXPECT_FALSE(dirty());
+    EXPECT_FALSE(populate(0.f, 3.f));
+
+    EXPECT_FALSE(compare_exchange(0.f, 2.f));
+    EXPECT_EQ(1.f, read());
+    EXPECT_FALSE(dirty());
+
+    EXPECT_TRUE(compare_exchange(1.f, 2.f));
+    EXPECT_EQ(2.f, read());
+    EXPECT_TRUE(dirty());
+
+    EXPECT_TRUE(clean());
+    EXPECT_FALSE(dirty());
+    EXPECT_FALSE(clean());
+
+    update(3.f);
+    EXPECT_TRUE(dirty());
+  }
+
+  TEST_F(RcuItemFixture, FetchUpdateST)
+  {
+    EXPECT_EQ(0.f, fetch_update([] (const float& value) { return value + 2.f; }));
+    EXPECT_EQ(2.f, read());
+    EXPECT_TRUE(dirty());
+
+    EXPECT_TRUE(clean());
+    EXPECT_ANY_THROW(fetch_update([] (const float&) -> float { throw std::runtime_error("function"); }));
+    EXPECT_EQ(2.f, read());
+    EXPECT_FALSE(dirty());
+
+    EXPECT_EQ(2.f, fetch_add(.5f));
+    EXPECT_EQ(2.5f, read());
+    EXPECT_TRUE(dirty());
+  }
+
+  TEST_F(RcuItemFixture, FetchAddMT)
+  {
+    std::promise<void> promise;
+    auto signal = promise.get_future().share();
+
+    std::vector<std::thread> threads;
+    threads.reserve(20);
+    
+    for (int i = 0; i < 20; ++i)
+    {
+      threads.emplace_back([this, signal]
+      {
+        signal.wait();
+
+        for (int i = 0; i < 1000; ++i)
+        {
+          if (i % 2 == 0)
+          {
+            fetch_add(1.f);
+          }
+          else
+          {
+            fetch_update([] (const float& value) { return value + 1.f; });
+          }
+        }
+      });
+    }
+
+    promise.set_value();
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    EXPECT_EQ(20000.f, read());
+  }
+
+  TEST_F(RcuItemFixture, SingleValueMT)
+  {
+    update(1.f);
+
+    std::promise<void> promise;
+    auto signal = promise.get_future().share();
+
+    std::vector<std::thread> threads;
+    threads.reserve(20);
+    
+    for (int i = 0; i < 20; ++i)
+    {
+      threads.emplace_back([this, signal]
+      {
+        signal.wait();
+
+        for (int i = 0; i < 10000; ++i)
+        {
+          ASSERT_EQ(1.f, read());
+          update(1.f);
+          ASSERT_EQ(1.f, read());
+        }
+      });
+    }
+
+    promise.set_value();
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+  }
+
+  TEST_F(RcuItemFixture, TwoValuesMT)
+  {
+    update(1.f);
+
+    std::promise<void> promise;
+    auto signal = promise.get_future().share();
+
+    std::vector<std::thread> threads;
+    threads.reserve(20);
+    
+    for (int i = 0; i < 20; ++i)
+    {
+      threads.emplace_back([this, signal]
+      {
+        signal.wait();
+
+        for (int i = 0; i < 10000; ++i)
+        {
+          {
+            auto value = read();
+            ASSERT_TRUE(1.f == value || -2.f == value) << "Actual: << " << value;
+          }
+
+          update(rand() % 2 == 0 ? 1.f : -2.f);
+
+          {
+            auto value = read();
+            ASSERT_TRUE(1.f == value || -2.f == value) << "Actual: << " << value;
+          }
+        }
+      });
+    }
+
+    promise.set_value();
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+  }
+
+  TEST_F(RcuItemFixture, DictionaryMT)
+  {
+    const static int size = 1000;
+
+    std::vector<float> sourceDictionary;
+    std::unordered_set<float> searchDictionary;
+    sourceDictionary.reserve(size);
+    searchDictionary.reserve(size);
+    for (int i = 0; i < size; ++i)
+    {
+      auto value = 1.f * (rand() % size) + .001f * (rand() % size);
+      sourceDictionary.push_back(value);
+      searchDictionary.insert(value);
+    }
+
+    update(sourceDictionary[0]);
+
+    std::promise<void> promise;
+    auto signal = promise.get_future().share();
+
+    std::vector<std::thread> threads;
+    threads.reserve(20);
+    
+    for (int i = 0; i < 20; ++i)
+    {
+      threads.emplace_back([this, &sourceDictionary, &searchDictionary, signal]
+      {
+        signal.wait();
+
+        for (int i = 0; i < 10000; ++i)
+        {
+          {
+            auto value = read();
+            auto iter = searchDictionary.find(value);
+            ASSERT_TRUE(iter != searchDictionary.end()) << "Actual: << " << value;
+          }
+
+          {
+            update(sourceDictionary[rand() % sourceDictionary.size()]);
+          }
+
+          {
+            auto value = read();
+            auto iter = searchDictionary.find(value);
+            ASSERT_TRUE(iter != searchDictionary.end()) << "Actual: << " << value;
+          }
+        }
+      });
+    }
+
+    promise.set_value();
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+  }
+
+  TEST(RcuItemTests, StringMT)
+  {
+    RcuItem<std::string> item(std::string(10, 'a'));
+
+    std::atomic<bool> stop(false);
+    std::vector<std::future<void>> readers;
+
+    for (int i = 0; i < 4; ++i)
+    {
+      readers.push_back(std::async(std::launch::async, [&item, &stop]
+      {
+        std::string buffer;
+
+        while (!stop.load())
+        {
+          // versions are never observed partially written or released
+          item.read_with([] (const std::string& value)
+          {
+            ASSERT_FALSE(value.empty());
+            ASSERT_EQ(std::string(value.size(), value.front()), value);
+          });
+
+          item.read_into(buffer);
+          ASSERT_EQ(std::string(buffer.size(), buffer.front()), buffer);
+        }
+      }));
+    }
+
+    for (int i = 0; i < 20000; ++i)
+    {
+      if (i % 2 == 0)
+      {
+        item.update(std::string(i % 100 + 1, static_cast<char>('a' + i % 26)));
+      }
+      else
+      {
+        item.fetch_update([] (const std::string& value) { return value + value.front(); });
+      }
+    }
+
+    stop.store(true);
+
+    for (auto& reader : readers)
+    {
+      reader.get();
+    }
+
+    EXPECT_TRUE(item.dirty());
+  }
+
+}
@@ -0,0 +1,237 @@
+#include <cache/fixed_string.h>
+#include <cache/item/seq_lock_item.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+  using namespace cache;
+
+  class SeqLockItemFixture : protected SeqLockItem<float>
+                           , public ::testing::Test
+  {
+  public:
+    SeqLockItemFixture()
+      : SeqLockItem<float>(0.f)
+    {
+    }
+  };
+
+  TEST_F(SeqLockItemFixture, UpdateAndReadST)
+  {
+    EXPECT_EQ(0.f, read());
+    EXPECT_EQ(0.f, read());
+
+    update(1.f);
+    EXPECT_EQ(1.f, read());
+    EXPECT_EQ(1.f, read());
+
+    update(61235.6f);
+    EXPECT_EQ(61235.6f, read());
+    EXPECT_EQ(61235.6f, read());
+
+    update(-61235.6f);
+    EXPECT_EQ(-61235.6f, read());
+    EXPECT_EQ(-61235.6f, read());
+  }
+
+  TEST_F(SeqLockItemFixture, ReadIntoST)
+  {
+    update(1.5f);
+
+    float value = 0.f;
+    read_into(value);
+    EXPECT_EQ(1.5f, value);
+
+    read_with([&value] (const float& current) { value = current + 1.f; });
+    EXPECT_EQ(2.5f, value);
+    EXPECT_EQ(1.5f, read());
+  }
+
+  TEST_F(SeqLockItemFixture, DirtyST)
+  {
+    EXPECT_FALSE(dirty());
+    EXPECT_FALSE(loaded());
+
+    // a loaded value equal to the default one still marks the item loaded
+    EXPECT_TRUE(populate(0.f, 0.f));
+    EXPECT_TRUE(loaded());
+    EXPECT_FALSE(dirty());
+
+    EXPECT_TRUE(populate(0.f, 1.f));
+    EXPECT_EQ(1.f, read());
+    EXPECT_FALSE(dirty());
+    EXPECT_FALSE(populate(0.f, 3.f));
+
+    EXPECT_FALSE(compare_exchange(0.f, 2.f));
+    EXPECT_EQ(1.f, read());
+    EXPECT_FALSE(dirty());
+
+    EXPECT_TRUE(compare_exchange(1.f, 2.f));
+    EXPECT_EQ(2.f, read());
+    EXPECT_TRUE(dirty());
+
+    EXPECT_TRUE(clean());
+    EXPECT_FALSE(dirty());
+
+    update(3.f);
+    EXPECT_TRUE(dirty());
+  }
+
+  TEST_F(SeqLockItemFixture, FetchUpdateST)
+  {
+    EXPECT_EQ(0.f, fetch_update([] (const float& value) { return value + 2.f; }));
+    EXPECT_EQ(2.f, read());
+    EXPECT_TRUE(dirty());
+
+    EXPECT_TRUE(clean());
+    EXPECT_ANY_THROW(fetch_update([] (const float&) -> float { throw std::runtime_error("function"); }));
+    EXPECT_EQ(2.f, read());
+    EXPECT_FALSE(dirty());
+
+    // the write lock is released by the exception
+    update(4.f);
+    EXPECT_EQ(4.f, read());
+
+    EXPECT_EQ(4.f, fetch_add(.5f));
+    EXPECT_EQ(4.5f, read());
+  }
+
+  TEST_F(SeqLockItemFixture, FetchAddMT)
+  {
+    std::promise<void> promise;
+    auto signal = promise.get_future().share();
+
+    std::vector<std::thread> threads;
+    threads.reserve(20);
+    
+    for (int i = 0; i < 20; ++i)
+    {
+      threads.emplace_back([this, signal]
+      {
+        signal.wait();
+
+        for (int i = 0; i < 1000; ++i)
+        {
+          if (i % 2 == 0)
+          {
+            fetch_add(1.f);
+          }
+          else
+          {
+            fetch_update([] (const float& value) { return value + 1.f; });
+          }
+        }
+      });
+    }
+
+    promise.set_value();
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    EXPECT_EQ(20000.f, read());
+  }
+
+  TEST_F(SeqLockItemFixture, TwoValuesMT)
+  {
+    update(1.f);
+
+    std::promise<void> promise;
+    auto signal = promise.get_future().share();
+
+    std::vector<std::thread> threads;
+    threads.reserve(20);
+    
+    for (int i = 0; i < 20; ++i)
+    {
+      threads.emplace_back([this, signal]
+      {
+        signal.wait();
+
+        for (int i = 0; i < 10000; ++i)
+        {
+          {
+            auto value = read();
+            ASSERT_TRUE(1.f == value || -2.f == value) << "Actual: << " << value;
+          }
+
+          update(rand() % 2 == 0 ? 1.f : -2.f);
+
+          {
+            auto value = read();
+            ASSERT_TRUE(1.f == value || -2.f == value) << "Actual: << " << value;
+          }
+        }
+      });
+    }
+
+    promise.set_value();
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+  }
+
+  TEST(SeqLockItemTests, FixedStringMT)
+  {
+    using Value = FixedString<23>;
+
+    SeqLockItem<Value> item(Value(std::string(10, 'a')));
+
+    std::atomic<bool> stop(false);
+    std::vector<std::future<void>> readers;
+
+    for (int i = 0; i < 4; ++i)
+    {
+      readers.push_back(std::async(std::launch::async, [&item, &stop]
+      {
+        Value buffer;
+
+        while (!stop.load())
+        {
+          // values are never observed partially written
+          item.read_into(buffer);
+          ASSERT_FALSE(buffer.empty());
+          ASSERT_EQ(std::string(buffer.size(), buffer.data()[0]), buffer.str());
+        }
+      }));
+    }
+
+    for (int i = 0; i < 20000; ++i)
+    {
+      if (i % 2 == 0)
+      {
+        item.update(Value(std::string(i % Value::capacity() + 1, static_cast<char>('a' + i % 26))));
+      }
+      else
+      {
+        item.fetch_update([] (const Value& value) 
+        { 
+          return Value(std::string(value.size() % Value::capacity() + 1, value.data()[0]));
+        });
+      }
+    }
+
+    stop.store(true);
+
+    for (auto& reader : readers)
+    {
+      reader.get();
+    }
+
+    EXPECT_TRUE(item.dirty());
+  }
+
+}
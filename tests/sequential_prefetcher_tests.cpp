@@ -0,0 +1,114 @@
+#include <cache/cache.h>
+#include <cache/sequential_prefetcher.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+  using namespace cache;
+
+  TEST(SequentialPrefetcherTests, Invalid)
+  {
+    auto prefetch = [] (int, size_t) {};
+
+    EXPECT_ANY_THROW(SequentialPrefetcher<int>(nullptr));
+    EXPECT_ANY_THROW(SequentialPrefetcher<int>(prefetch, 0));
+    EXPECT_ANY_THROW(SequentialPrefetcher<int>(prefetch, 8, 0));
+  }
+
+  TEST(SequentialPrefetcherTests, Runs)
+  {
+    std::vector<std::pair<int, size_t>> ranges;
+
+    SequentialPrefetcher<int> prefetcher([&ranges] (int first, size_t count)
+    {
+      ranges.emplace_back(first, count);
+    }, 8, 3);
+
+    // random accesses and runs shorter than runLength do not prefetch
+    for (int key : { 5, 17, 3, 4, 10, 20, 21 })
+    {
+      prefetcher.access(key);
+      prefetcher.wait();
+    }
+
+    EXPECT_EQ(0, prefetcher.prefetches());
+
+    for (int key = 22; key < 38; ++key)
+    {
+      prefetcher.access(key);
+      prefetcher.wait();
+    }
+
+    // the first prefetch covers the whole distance, the next ones keep it ahead once half of it is consumed
+    std::vector<std::pair<int, size_t>> expected({ { 23, 8 }, { 31, 4 }, { 35, 4 }, { 39, 4 } });
+    EXPECT_EQ(expected, ranges);
+    EXPECT_EQ(4, prefetcher.prefetches());
+
+    // a new run starts over
+    ranges.clear();
+    for (int key : { 100, 101, 102 })
+    {
+      prefetcher.access(key);
+      prefetcher.wait();
+    }
+
+    expected.assign({ { 103, 8 } });
+    EXPECT_EQ(expected, ranges);
+  }
+
+  TEST(SequentialPrefetcherTests, Exception)
+  {
+    SequentialPrefetcher<int> prefetcher([] (int, size_t)
+    {
+      throw std::runtime_error("Failed to prefetch");
+    }, 4, 1);
+
+    prefetcher.access(1);
+    EXPECT_ANY_THROW(prefetcher.wait());
+
+    prefetcher.access(10);
+  }
+
+  TEST(SequentialPrefetcherTests, CacheMT)
+  {
+    Cache<int, int> cache(1000, [] (const int&, const int&) noexcept {});
+
+    SequentialPrefetcher<int> prefetcher([&cache] (int first, size_t count)
+    {
+      std::vector<std::pair<int, int>> items;
+      for (size_t i = 0; i < count; ++i)
+      {
+        items.emplace_back(first + static_cast<int>(i), 2 * (first + static_cast<int>(i)));
+      }
+
+      cache.insert(items.begin(), items.end());
+    }, 64);
+
+    size_t prefetched = 0;
+    for (int key = 1; key <= 500; ++key)
+    {
+      prefetcher.access(key);
+
+      // lets the prefetch land before the lookup, as a slower consumer would
+      prefetcher.wait();
+
+      auto value = cache[key]->read();
+      if (value != 0)
+      {
+        EXPECT_EQ(2 * key, value);
+        ++prefetched;
+      }
+    }
+
+    // only the keys detecting the run are missed
+    EXPECT_EQ(496, prefetched);
+    EXPECT_EQ(4, cache.stats().misses);
+  }
+
+}
@@ -36,4 +36,22 @@ namespace
     hook("bcd", -5);
   }
 
+  TEST(UpdateHookTests, Reason)
+  {
+    bool called = false;
+
+    auto closure = [&called] (const int& key, const std::string& value, UpdateReason reason) noexcept
+    {
+      EXPECT_EQ(7, key);
+      EXPECT_EQ("abc", value);
+      EXPECT_EQ(UpdateReason::Destroyed, reason);
+      called = true;
+    };
+
+    auto hook = make_update_hook<int, std::string>(std::move(closure));
+
+    hook(7, "abc", UpdateReason::Destroyed);
+    EXPECT_TRUE(called);
+  }
+
 }
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <memory>
+
+namespace utility
+{
+
+  /**
+   * \class EpochDomain
+   * \brief Epoch-based reclamation of objects shared with lock-free readers
+   * \details Readers pin the current epoch while they use raw references to shared objects. Objects removed from
+   * shared structures are retired instead of being released, and released once every reader which could still
+   * reference them has unpinned. Pinning only increments a counter of a per-thread cache-line-aligned slot, so
+   * readers do not write to shared cache lines (unless there are more threads than slots).
+   * Retired objects are appended to the list of a per-thread slot under its own lock, so concurrent writers do not
+   * contend, and are released in batches by the threads retiring them, without waiting for readers; only releasing
+   * takes the lock of the domain.
+   * All non-special member functions are threadsafe
+   */
+  class EpochDomain
+  {
+  private:
+    class Impl;
+
+  public:
+    /**
+     * \class Guard
+     * \brief Pin of an epoch, released on destruction
+     */
+    class Guard
+    {
+    public:
+      /**
+       * \brief Creates a guard pinning nothing
+       */
+      Guard() noexcept;
+
+      Guard(Guard&& other) noexcept;
+      Guard& operator=(Guard&& other) noexcept;
+
+      /**
+       * \brief Unpins the epoch
+       */
+      ~Guard();
+
+      /**
+       * \brief Returns true if the guard pins an epoch of a given domain
+       */
+      bool pins(const EpochDomain& domain) const noexcept;
+
+    private:
+      friend class EpochDomain;
+
+      Guard(const EpochDomain* domain, size_t epoch) noexcept;
+      void reset() noexcept;
+
+    private:
+      const EpochDomain* m_domain;
+      size_t m_epoch;
+    };
+
+  public:
+    /**
+     * \brief Constructor
+     * \details The number of reader and retire slots is the number of hardware threads rounded up to a power of 2
+     */
+    EpochDomain();
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    /**
+     * \brief Releases all retired objects
+     * \details No thread may pin the domain anymore
+     */
+    ~EpochDomain();
+
+    /**
+     * \brief Pins the current epoch for the calling thread
+     * \details Objects retired after the call are not released until the guard is destroyed. Pins may be nested
+     */
+    Guard pin() const noexcept;
+
+    /**
+     * \brief Releases an object once no reader pinned before the call is pinned anymore
+     * \details The object must have been made unreachable to readers pinning later. Every few calls,
+     * the epoch is advanced if possible and objects retired long enough ago are released by the calling thread,
+     * outside of any lock of the domain, so their destructors may retire other objects
+     * \param object - object to release, ignored if null
+     * \throw if memory cannot be allocated
+     */
+    void retire(std::shared_ptr<const void> object);
+
+    /**
+     * \brief Advances the epoch if possible and releases the objects which are no longer referenced by readers
+     * \details Without pinned readers, all objects retired before the call are released
+     * \return number of released objects
+     */
+    size_t collect();
+
+    /**
+     * \brief Returns the number of retired objects not yet released
+     */
+    size_t retired() const;
+
+  private:
+    std::unique_ptr<Impl> m_impl;
+  };
+
+}
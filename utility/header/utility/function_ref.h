@@ -0,0 +1,54 @@
+#pragma once
+
+#include <type_traits>
+
+namespace utility
+{
+
+  template <typename Signature>
+  class FunctionRef;
+
+  /**
+   * \class FunctionRef
+   * \brief Non-owning reference to a function object
+   * \details Unlike std::function, the function object is neither copied nor allocated: a pointer to it is called
+   * through a trampoline, so FunctionRef must not outlive it. Used to pass function objects to virtual functions
+   * \tparam Result - return type of the function object
+   * \tparam Args - argument types of the function object
+   */
+  template <typename Result, typename... Args>
+  class FunctionRef<Result(Args...)>
+  {
+  public:
+    /**
+     * \brief Constructor
+     * \param function - function object callable with Args, referenced for the lifetime of FunctionRef
+     */
+    template <
+      typename Function, 
+      typename std::enable_if_t<
+        !std::is_same<
+          std::decay_t<Function>, 
+          FunctionRef
+        >::value
+      >* = nullptr
+    >
+    FunctionRef(Function&& function) noexcept;
+
+    /**
+     * \brief Calls the referenced function object
+     */
+    Result operator()(Args... args) const;
+
+  private:
+    template <typename Function>
+    static Result call(void* function, Args... args);
+
+  private:
+    void* m_function;
+    Result (*m_call)(void*, Args...);
+  };
+
+}
+
+#include <utility/function_ref.hpp>
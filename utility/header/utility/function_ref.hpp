@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+namespace utility
+{
+
+  template <typename Result, typename... Args>
+  template <
+    typename Function,
+    typename std::enable_if_t<
+      !std::is_same<
+        std::decay_t<Function>, 
+        FunctionRef<Result(Args...)>
+      >::value
+    >*
+  >
+  FunctionRef<Result(Args...)>::FunctionRef(Function&& function) noexcept
+    : m_function(const_cast<void*>(static_cast<const void*>(std::addressof(function))))
+    , m_call(&call<std::remove_reference_t<Function>>)
+  {
+  }
+
+  template <typename Result, typename... Args>
+  Result FunctionRef<Result(Args...)>::operator()(Args... args) const
+  {
+    return m_call(m_function, std::forward<Args>(args)...);
+  }
+
+  template <typename Result, typename... Args>
+  template <typename Function>
+  Result FunctionRef<Result(Args...)>::call(void* function, Args... args)
+  {
+    return (*static_cast<Function*>(function))(std::forward<Args>(args)...);
+  }
+
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace utility
+{
+
+  /**
+   * \class BasicHistogram
+   * \brief Log-linear histogram of unsigned integer values (e.g. latencies in nanoseconds)
+   * \details Each power of 2 is split into 16 linear sub-buckets, so any recorded value is reported with
+   * a relative error below 1/16 while the whole 64-bit range takes a fixed amount of memory
+   * \tparam Counter - type of bucket counters: uint64_t for single-threaded recording,
+   * std::atomic<uint64_t> for concurrent recording
+   */
+  template <typename Counter>
+  class BasicHistogram
+  {
+  public:
+    static constexpr size_t SubBucketBits = 4;
+    static constexpr size_t SubBucketCount = size_t(1) << SubBucketBits;
+    static constexpr size_t BucketCount = (64 - SubBucketBits + 1) * SubBucketCount;
+
+  public:
+    BasicHistogram() noexcept;
+
+    /**
+     * \brief Records a value
+     */
+    void record(uint64_t value) noexcept;
+
+    /**
+     * \brief Adds all values recorded in another histogram
+     */
+    template <typename OtherCounter>
+    void merge(const BasicHistogram<OtherCounter>& other) noexcept;
+
+    /**
+     * \brief Returns the number of recorded values
+     */
+    uint64_t count() const noexcept;
+
+    /**
+     * \brief Returns the sum of recorded values
+     */
+    uint64_t sum() const noexcept;
+
+    /**
+     * \brief Returns the mean of recorded values, or 0 if no values were recorded
+     */
+    double mean() const noexcept;
+
+    /**
+     * \brief Returns the smallest bucket bound not exceeded by the given share of recorded values
+     * \param quantile - share of values, from 0 to 1 (e.g. 0.99 for the 99th percentile)
+     * \return 0 if no values were recorded
+     */
+    uint64_t percentile(double quantile) const noexcept;
+
+    /**
+     * \brief Returns the number of values recorded in the bucket of a given index
+     */
+    uint64_t bucket(size_t index) const noexcept;
+
+    /**
+     * \brief Returns the index of the bucket a value is recorded in
+     */
+    static size_t bucket_index(uint64_t value) noexcept;
+
+    /**
+     * \brief Returns the largest value recorded in the bucket of a given index
+     */
+    static uint64_t bucket_upper_bound(size_t index) noexcept;
+
+  private:
+    static void add(uint64_t& counter, uint64_t value) noexcept;
+    static void add(std::atomic<uint64_t>& counter, uint64_t value) noexcept;
+    static uint64_t load(const uint64_t& counter) noexcept;
+    static uint64_t load(const std::atomic<uint64_t>& counter) noexcept;
+
+  private:
+    std::array<Counter, BucketCount> m_buckets;
+    Counter m_count;
+    Counter m_sum;
+  };
+
+  /**
+   * \class Histogram
+   * \brief Histogram recorded by a single thread at a time
+   */
+  using Histogram = BasicHistogram<uint64_t>;
+
+  /**
+   * \class ConcurrentHistogram
+   * \brief Histogram which can be recorded concurrently
+   */
+  using ConcurrentHistogram = BasicHistogram<std::atomic<uint64_t>>;
+
+}
+
+#include <utility/histogram.hpp>
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace utility
+{
+
+  namespace detail
+  {
+
+    // index of the most significant set bit of a non-zero value
+    inline size_t most_significant_bit(uint64_t value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<size_t>(63 - __builtin_clzll(value));
+#else
+      size_t result = 0;
+      for (size_t shift = 32; shift > 0; shift /= 2)
+      {
+        if (value >> shift)
+        {
+          value >>= shift;
+          result += shift;
+        }
+      }
+
+      return result;
+#endif
+    }
+
+  }
+
+  template <typename Counter>
+  BasicHistogram<Counter>::BasicHistogram() noexcept
+  {
+    for (auto& bucket : m_buckets)
+    {
+      bucket = 0;
+    }
+
+    m_count = 0;
+    m_sum = 0;
+  }
+
+  template <typename Counter>
+  void BasicHistogram<Counter>::record(uint64_t value) noexcept
+  {
+    add(m_buckets[bucket_index(value)], 1);
+    add(m_count, 1);
+    add(m_sum, value);
+  }
+
+  template <typename Counter>
+  template <typename OtherCounter>
+  void BasicHistogram<Counter>::merge(const BasicHistogram<OtherCounter>& other) noexcept
+  {
+    uint64_t count = 0;
+
+    for (size_t i = 0; i < BucketCount; ++i)
+    {
+      auto value = other.bucket(i);
+      add(m_buckets[i], value);
+      count += value;
+    }
+
+    add(m_count, count);
+    add(m_sum, other.sum());
+  }
+
+  template <typename Counter>
+  uint64_t BasicHistogram<Counter>::count() const noexcept
+  {
+    return load(m_count);
+  }
+
+  template <typename Counter>
+  uint64_t BasicHistogram<Counter>::sum() const noexcept
+  {
+    return load(m_sum);
+  }
+
+  template <typename Counter>
+  double BasicHistogram<Counter>::mean() const noexcept
+  {
+    auto count = load(m_count);
+
+    return count == 0 ? 0. : static_cast<double>(load(m_sum)) / count;
+  }
+
+  template <typename Counter>
+  uint64_t BasicHistogram<Counter>::percentile(double quantile) const noexcept
+  {
+    uint64_t total = 0;
+    for (const auto& bucket : m_buckets)
+    {
+      total += load(bucket);
+    }
+
+    if (total == 0)
+    {
+      return 0;
+    }
+
+    auto rank = static_cast<uint64_t>(std::ceil(std::min(std::max(quantile, 0.), 1.) * total));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BucketCount; ++i)
+    {
+      seen += load(m_buckets[i]);
+
+      if (seen >= rank)
+      {
+        return bucket_upper_bound(i);
+      }
+    }
+
+    return bucket_upper_bound(BucketCount - 1);
+  }
+
+  template <typename Counter>
+  uint64_t BasicHistogram<Counter>::bucket(size_t index) const noexcept
+  {
+    return load(m_buckets[index]);
+  }
+
+  template <typename Counter>
+  size_t BasicHistogram<Counter>::bucket_index(uint64_t value) noexcept
+  {
+    if (value < SubBucketCount)
+    {
+      return static_cast<size_t>(value);
+    }
+
+    auto msb = detail::most_significant_bit(value);
+    auto shift = msb - SubBucketBits;
+    auto group = shift + 1;
+    auto subBucket = static_cast<size_t>(value >> shift) - SubBucketCount;
+
+    return group * SubBucketCount + subBucket;
+  }
+
+  template <typename Counter>
+  uint64_t BasicHistogram<Counter>::bucket_upper_bound(size_t index) noexcept
+  {
+    auto group = index / SubBucketCount;
+    auto subBucket = index % SubBucketCount;
+
+    if (group == 0)
+    {
+      return subBucket;
+    }
+
+    auto shift = group - 1;
+    auto lower = static_cast<uint64_t>(SubBucketCount + subBucket) << shift;
+
+    return lower + ((uint64_t(1) << shift) - 1);
+  }
+
+  template <typename Counter>
+  void BasicHistogram<Counter>::add(uint64_t& counter, uint64_t value) noexcept
+  {
+    counter += value;
+  }
+
+  template <typename Counter>
+  void BasicHistogram<Counter>::add(std::atomic<uint64_t>& counter, uint64_t value) noexcept
+  {
+    counter.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  template <typename Counter>
+  uint64_t BasicHistogram<Counter>::load(const uint64_t& counter) noexcept
+  {
+    return counter;
+  }
+
+  template <typename Counter>
+  uint64_t BasicHistogram<Counter>::load(const std::atomic<uint64_t>& counter) noexcept
+  {
+    return counter.load(std::memory_order_relaxed);
+  }
+
+}
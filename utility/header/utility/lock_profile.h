@@ -0,0 +1,201 @@
+#pragma once
+
+#include <utility/histogram.h>
+#include <utility/per_thread_array.h>
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace utility
+{
+
+  /**
+   * \class LockProfile
+   * \brief Collects wait and hold times of all locks sharing a name
+   * \details Times are recorded in nanoseconds. An acquisition is counted as contended if the lock
+   * could not be taken without blocking. Each thread records into its own shard of a PerThreadArray,
+   * so locks sharing a profile do not contend on it; shards are merged on report
+   */
+  class LockProfile
+  {
+  public:
+    /**
+     * \brief Constructor
+     * \param name - name the profile is reported under
+     */
+    explicit LockProfile(const std::string& name);
+
+    ~LockProfile();
+
+    LockProfile(const LockProfile&) = delete;
+    LockProfile& operator=(const LockProfile&) = delete;
+
+    /**
+     * \brief Records a lock acquisition
+     * \param wait - time spent waiting for the lock
+     * \param contended - true if the lock was not available right away
+     */
+    void record_acquisition(uint64_t wait, bool contended) noexcept;
+
+    /**
+     * \brief Records the time a lock was held for
+     */
+    void record_hold(uint64_t hold) noexcept;
+
+    /**
+     * \brief Returns the name of the profile
+     */
+    const std::string& name() const noexcept;
+
+    /**
+     * \brief Returns the histogram of wait times merged from all shards
+     */
+    Histogram wait_times() const noexcept;
+
+    /**
+     * \brief Returns the histogram of hold times merged from all shards
+     */
+    Histogram hold_times() const noexcept;
+
+    /**
+     * \brief Returns the number of acquisitions which had to wait for the lock
+     */
+    uint64_t contended() const noexcept;
+
+    /**
+     * \brief Returns the number of acquisitions which did not have to wait for the lock
+     */
+    uint64_t uncontended() const noexcept;
+
+    /**
+     * \brief Prints acquisition counts and wait/hold time percentiles
+     */
+    void print(std::ostream& stream) const;
+
+  private:
+    struct Shard;
+
+  private:
+    const std::string m_name;
+    PerThreadArray<Shard> m_shards;
+  };
+
+  /**
+   * \brief Returns the process-wide LockProfile of a given name, creating it on first use
+   * \details The returned reference stays valid until the process ends. The lookup takes a global lock, so
+   * code creating locks often should look the profile up once and keep the reference
+   */
+  LockProfile& lock_profile(const std::string& name);
+
+  /**
+   * \brief Prints all process-wide LockProfiles in alphabetical order of their names
+   */
+  void print_lock_profiles(std::ostream& stream);
+
+  /**
+   * \class ProfilingMutex
+   * \brief Wraps a mutex, recording wait and hold times of its locks into a LockProfile
+   * \details Hold times are only recorded for exclusive ownership, since shared owners do not
+   * have a single acquisition time to measure from
+   * \tparam Mutex - wrapped mutex type
+   */
+  template <typename Mutex>
+  class ProfilingMutex
+  {
+  public:
+    /**
+     * \brief Constructor
+     * \param profile - LockProfile to record into (see lock_profile)
+     */
+    explicit ProfilingMutex(LockProfile& profile);
+
+    ProfilingMutex(const ProfilingMutex&) = delete;
+    ProfilingMutex& operator=(const ProfilingMutex&) = delete;
+
+    void lock();
+    bool try_lock();
+    void unlock();
+
+    void lock_shared();
+    bool try_lock_shared();
+    void unlock_shared();
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    static uint64_t elapsed(Clock::time_point since) noexcept;
+
+  private:
+    Mutex m_mutex;
+    LockProfile& m_profile;
+    Clock::time_point m_acquired;
+  };
+
+  /**
+   * \class NoLockProfile
+   * \brief Empty tag standing for a LockProfile when lock profiling is compiled out
+   */
+  struct NoLockProfile
+  {
+  };
+
+  /**
+   * \class PlainMutex
+   * \brief Mutex accepting (and ignoring) a NoLockProfile, used when lock profiling is compiled out
+   */
+  template <typename Mutex>
+  class PlainMutex : public Mutex
+  {
+  public:
+    PlainMutex() = default;
+
+    explicit PlainMutex(NoLockProfile) noexcept
+    {
+    }
+  };
+
+  /**
+   * \class ProfiledMutex
+   * \brief Mutex used for library locks: a ProfilingMutex if CACHE_LOCK_PROFILING is defined, otherwise
+   * the plain mutex with no overhead
+   */
+#ifdef CACHE_LOCK_PROFILING
+  template <typename Mutex>
+  using ProfiledMutex = ProfilingMutex<Mutex>;
+#else
+  template <typename Mutex>
+  using ProfiledMutex = PlainMutex<Mutex>;
+#endif
+
+  /**
+   * \class LockProfileRef
+   * \brief Profile passed to a ProfiledMutex: a reference to a LockProfile if CACHE_LOCK_PROFILING is defined,
+   * otherwise an empty NoLockProfile
+   */
+#ifdef CACHE_LOCK_PROFILING
+  using LockProfileRef = LockProfile&;
+#else
+  using LockProfileRef = NoLockProfile;
+#endif
+
+  /**
+   * \brief Returns the profile of a given name to pass to a ProfiledMutex (see lock_profile)
+   * \details Neither looks anything up nor creates a LockProfile if lock profiling is compiled out
+   */
+#ifdef CACHE_LOCK_PROFILING
+  inline LockProfileRef profiled_lock(const char* name)
+  {
+    return lock_profile(name);
+  }
+#else
+  constexpr LockProfileRef profiled_lock(const char*) noexcept
+  {
+    return {};
+  }
+#endif
+
+}
+
+#include <utility/lock_profile.hpp>
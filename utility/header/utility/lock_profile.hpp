@@ -0,0 +1,91 @@
+#pragma once
+
+namespace utility
+{
+
+  template <typename Mutex>
+  ProfilingMutex<Mutex>::ProfilingMutex(LockProfile& profile)
+    : m_profile(profile)
+  {
+  }
+
+  template <typename Mutex>
+  void ProfilingMutex<Mutex>::lock()
+  {
+    if (m_mutex.try_lock())
+    {
+      m_profile.record_acquisition(0, false);
+    }
+    else
+    {
+      auto start = Clock::now();
+      m_mutex.lock();
+      m_profile.record_acquisition(elapsed(start), true);
+    }
+
+    m_acquired = Clock::now();
+  }
+
+  template <typename Mutex>
+  bool ProfilingMutex<Mutex>::try_lock()
+  {
+    if (!m_mutex.try_lock())
+    {
+      return false;
+    }
+
+    m_profile.record_acquisition(0, false);
+    m_acquired = Clock::now();
+
+    return true;
+  }
+
+  template <typename Mutex>
+  void ProfilingMutex<Mutex>::unlock()
+  {
+    auto hold = elapsed(m_acquired);
+    m_mutex.unlock();
+    m_profile.record_hold(hold);
+  }
+
+  template <typename Mutex>
+  void ProfilingMutex<Mutex>::lock_shared()
+  {
+    if (m_mutex.try_lock_shared())
+    {
+      m_profile.record_acquisition(0, false);
+    }
+    else
+    {
+      auto start = Clock::now();
+      m_mutex.lock_shared();
+      m_profile.record_acquisition(elapsed(start), true);
+    }
+  }
+
+  template <typename Mutex>
+  bool ProfilingMutex<Mutex>::try_lock_shared()
+  {
+    if (!m_mutex.try_lock_shared())
+    {
+      return false;
+    }
+
+    m_profile.record_acquisition(0, false);
+
+    return true;
+  }
+
+  template <typename Mutex>
+  void ProfilingMutex<Mutex>::unlock_shared()
+  {
+    m_mutex.unlock_shared();
+  }
+
+  template <typename Mutex>
+  uint64_t ProfilingMutex<Mutex>::elapsed(Clock::time_point since) noexcept
+  {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - since).count());
+  }
+
+}
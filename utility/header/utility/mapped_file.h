@@ -0,0 +1,50 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace utility
+{
+
+  /**
+   * \class MappedFile
+   * \brief Read-only view of the contents of a file
+   * \details The file is memory-mapped where supported (POSIX), so its pages are only read once accessed.
+   * Elsewhere, the contents are read into memory on construction
+   */
+  class MappedFile
+  {
+  private:
+    class Impl;
+
+  public:
+    /**
+     * \brief Constructor
+     * \param path - path to the file
+     * \throw if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * \brief Returns a pointer to the first byte of the file
+     */
+    const char* data() const noexcept;
+
+    /**
+     * \brief Returns the size of the file in bytes
+     */
+    size_t size() const noexcept;
+
+    /**
+     * \brief Unmaps the file
+     */
+    ~MappedFile();
+
+  private:
+    std::unique_ptr<Impl> m_impl;
+  };
+
+}
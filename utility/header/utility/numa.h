@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace utility
+{
+
+  /**
+   * \brief Returns the number of NUMA nodes of the machine
+   * \return 1 if the machine is not NUMA or the topology is unavailable (non-Linux systems)
+   */
+  size_t numa_node_count() noexcept;
+
+  /**
+   * \brief Returns the NUMA node of the CPU the calling thread is running on
+   * \return 0 if unavailable
+   */
+  size_t numa_current_node() noexcept;
+
+  /**
+   * \brief Restricts the calling thread to the CPUs of a given NUMA node
+   * \return false if the node is unknown or thread affinity is unsupported, in which case the affinity is unchanged
+   */
+  bool numa_bind_thread(size_t node) noexcept;
+
+  /**
+   * \brief Allocates page-aligned memory preferably placed on a given NUMA node
+   * \details Falls back to memory on any node where placement is unavailable
+   * \throw std::bad_alloc if memory cannot be allocated
+   */
+  void* numa_allocate(size_t bytes, size_t node);
+
+  /**
+   * \brief Frees memory allocated by numa_allocate
+   * \param bytes - size passed to numa_allocate
+   */
+  void numa_free(void* ptr, size_t bytes) noexcept;
+
+  /**
+   * \class NumaArena
+   * \brief Threadsafe allocator of small objects placed on a given NUMA node
+   * \details Memory is carved from large node-bound chunks, freed blocks being reused for allocations of the same
+   * size class. Larger objects are allocated with numa_allocate directly. Chunks are returned to the system on
+   * destruction, so the arena must outlive all objects allocated from it
+   */
+  class NumaArena
+  {
+  public:
+    /**
+     * \brief Constructor
+     * \param node - NUMA node to place memory on
+     */
+    explicit NumaArena(size_t node);
+
+    NumaArena(const NumaArena&) = delete;
+    NumaArena& operator=(const NumaArena&) = delete;
+
+    /**
+     * \brief Allocates memory aligned for any scalar type
+     * \throw std::bad_alloc if memory cannot be allocated
+     */
+    void* allocate(size_t bytes);
+
+    /**
+     * \brief Frees memory allocated by allocate
+     * \param bytes - size passed to allocate
+     */
+    void deallocate(void* ptr, size_t bytes) noexcept;
+
+    /**
+     * \brief Returns the NUMA node memory is placed on
+     */
+    size_t node() const noexcept;
+
+    ~NumaArena();
+
+  private:
+    static constexpr size_t BlockAlignment = 16;
+    static constexpr size_t MaxBlockSize = 1024;
+    static constexpr size_t ChunkSize = 256 * 1024;
+
+    struct FreeBlock
+    {
+      FreeBlock* next;
+    };
+
+  private:
+    const size_t m_node;
+    std::mutex m_mutex;
+    std::vector<FreeBlock*> m_freeBlocks;
+    std::vector<void*> m_chunks;
+    char* m_next;
+    char* m_end;
+  };
+
+  /**
+   * \class NumaAllocator
+   * \brief Standard allocator placing objects in a shared NumaArena
+   * \details Each copy of the allocator keeps the arena alive, so containers and shared pointers using it may
+   * outlive their creator. Without an arena, objects are allocated with the global operator new
+   * \tparam T - type of allocated objects
+   */
+  template <typename T>
+  class NumaAllocator
+  {
+  public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+      using other = NumaAllocator<U>;
+    };
+
+  public:
+    /**
+     * \brief Constructor
+     * \param arena - arena to allocate objects in, or null to use the global operator new
+     */
+    explicit NumaAllocator(const std::shared_ptr<NumaArena>& arena = nullptr) noexcept;
+
+    template <typename U>
+    NumaAllocator(const NumaAllocator<U>& other) noexcept;
+
+    T* allocate(size_t count);
+    void deallocate(T* ptr, size_t count) noexcept;
+
+    const std::shared_ptr<NumaArena>& arena() const noexcept;
+
+  private:
+    std::shared_ptr<NumaArena> m_arena;
+  };
+
+  template <typename T, typename U>
+  bool operator==(const NumaAllocator<T>& left, const NumaAllocator<U>& right) noexcept;
+
+  template <typename T, typename U>
+  bool operator!=(const NumaAllocator<T>& left, const NumaAllocator<U>& right) noexcept;
+
+}
+
+#include <utility/numa.hpp>
@@ -0,0 +1,60 @@
+#pragma once
+
+namespace utility
+{
+
+  template <typename T>
+  NumaAllocator<T>::NumaAllocator(const std::shared_ptr<NumaArena>& arena) noexcept
+    : m_arena(arena)
+  {
+  }
+
+  template <typename T>
+  template <typename U>
+  NumaAllocator<T>::NumaAllocator(const NumaAllocator<U>& other) noexcept
+    : m_arena(other.arena())
+  {
+  }
+
+  template <typename T>
+  T* NumaAllocator<T>::allocate(size_t count)
+  {
+    if (!m_arena)
+    {
+      return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+
+    return static_cast<T*>(m_arena->allocate(count * sizeof(T)));
+  }
+
+  template <typename T>
+  void NumaAllocator<T>::deallocate(T* ptr, size_t count) noexcept
+  {
+    if (!m_arena)
+    {
+      ::operator delete(ptr);
+      return;
+    }
+
+    m_arena->deallocate(ptr, count * sizeof(T));
+  }
+
+  template <typename T>
+  const std::shared_ptr<NumaArena>& NumaAllocator<T>::arena() const noexcept
+  {
+    return m_arena;
+  }
+
+  template <typename T, typename U>
+  bool operator==(const NumaAllocator<T>& left, const NumaAllocator<U>& right) noexcept
+  {
+    return left.arena() == right.arena();
+  }
+
+  template <typename T, typename U>
+  bool operator!=(const NumaAllocator<T>& left, const NumaAllocator<U>& right) noexcept
+  {
+    return !(left == right);
+  }
+
+}
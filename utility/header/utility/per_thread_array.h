@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace utility
+{
+
+  /**
+   * \brief Size of a cache line assumed for padding of data modified by different threads
+   */
+  constexpr size_t CacheLineSize = 64;
+
+  /**
+   * \brief Returns a small index unique to the calling thread
+   * \details Indices are assigned sequentially on the first call from each thread
+   */
+  size_t thread_index() noexcept;
+
+  /**
+   * \class PerThreadArray
+   * \brief Array of value-initialized objects, each starting on its own cache line, one per thread index
+   * \details Each thread uses the object of its own thread index, so objects modified by different threads do not
+   * share cache lines (unless there are more threads than objects). The number of objects is the number of hardware
+   * threads rounded up to a power of 2
+   * \tparam Type - type of objects, which need only be complete where the constructor and destructor are used
+   */
+  template <typename Type>
+  class PerThreadArray
+  {
+  public:
+    PerThreadArray();
+    ~PerThreadArray();
+
+    PerThreadArray(const PerThreadArray&) = delete;
+    PerThreadArray& operator=(const PerThreadArray&) = delete;
+
+    /**
+     * \brief Returns the object of the calling thread
+     */
+    Type& local() const noexcept;
+
+    /**
+     * \brief Returns the object of a given index, wrapped around the number of objects
+     */
+    Type& operator[](size_t index) const noexcept;
+
+    /**
+     * \brief Returns the number of objects
+     */
+    size_t size() const noexcept;
+
+  private:
+    static size_t slot_size() noexcept;
+
+  private:
+    size_t m_mask;
+    std::unique_ptr<unsigned char[]> m_storage;
+    unsigned char* m_slots;
+  };
+
+}
+
+#include <utility/per_thread_array.hpp>
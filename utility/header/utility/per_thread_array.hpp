@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <new>
+#include <thread>
+
+namespace utility
+{
+
+  template <typename Type>
+  PerThreadArray<Type>::PerThreadArray()
+  {
+    size_t count = 1;
+    while (count < std::thread::hardware_concurrency())
+    {
+      count *= 2;
+    }
+
+    m_mask = count - 1;
+    m_storage.reset(new unsigned char[count * slot_size() + CacheLineSize]);
+
+    auto address = reinterpret_cast<uintptr_t>(m_storage.get());
+    m_slots = m_storage.get() + (CacheLineSize - address % CacheLineSize) % CacheLineSize;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      new (m_slots + i * slot_size()) Type();
+    }
+  }
+
+  template <typename Type>
+  PerThreadArray<Type>::~PerThreadArray()
+  {
+    for (size_t i = 0; i <= m_mask; ++i)
+    {
+      (*this)[i].~Type();
+    }
+  }
+
+  template <typename Type>
+  Type& PerThreadArray<Type>::local() const noexcept
+  {
+    return (*this)[thread_index()];
+  }
+
+  template <typename Type>
+  Type& PerThreadArray<Type>::operator[](size_t index) const noexcept
+  {
+    return *reinterpret_cast<Type*>(m_slots + (index & m_mask) * slot_size());
+  }
+
+  template <typename Type>
+  size_t PerThreadArray<Type>::size() const noexcept
+  {
+    return m_mask + 1;
+  }
+
+  template <typename Type>
+  size_t PerThreadArray<Type>::slot_size() noexcept
+  {
+    return (sizeof(Type) + CacheLineSize - 1) / CacheLineSize * CacheLineSize;
+  }
+
+}
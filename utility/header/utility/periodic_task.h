@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace utility
+{
+
+  /**
+   * \class PeriodicTask
+   * \brief Executes a task on a background thread at a fixed interval until destroyed
+   * \details Exceptions thrown by the task are printed and do not stop further executions
+   */
+  class PeriodicTask
+  {
+  private:
+    class Impl;
+
+  public:
+    /**
+     * \class Task
+     * \brief Task to be executed periodically
+     */
+    using Task = std::function<void()>;
+
+  public:
+    /**
+     * \brief Constructor
+     * \details The first execution takes place one interval after construction
+     * \param interval - time between the end of an execution and the start of the next one
+     * \param task - task to execute
+     * \throw if interval is not positive
+     */
+    PeriodicTask(std::chrono::milliseconds interval, const Task& task);
+
+    PeriodicTask(const PeriodicTask&) = delete;
+    PeriodicTask& operator=(const PeriodicTask&) = delete;
+
+    /**
+     * \brief Stops the background thread, waiting for the current execution (if any) to complete
+     */
+    ~PeriodicTask();
+
+  private:
+    std::unique_ptr<Impl> m_impl;
+  };
+
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+namespace utility
+{
+
+  /**
+   * \brief Returns the resident set size of the current process in bytes
+   * \details Read from /proc/self/statm, so only available on Linux. Memory freed by the process may remain
+   * resident until the allocator returns it to the system
+   * \return 0 if the resident set size is unavailable
+   */
+  size_t resident_memory() noexcept;
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <utility/per_thread_array.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace utility
+{
+
+  /**
+   * \class ShardedCounters
+   * \brief Set of counters split into per-thread shards aggregated on read
+   * \details Each thread increments the counters of its own shard of a PerThreadArray, so concurrent increments
+   * do not contend on the same cache line (unless there are more threads than shards).
+   * All non-special member functions are threadsafe
+   * \tparam Count - number of counters
+   */
+  template <size_t Count>
+  class ShardedCounters
+  {
+  private:
+    struct Shard
+    {
+      std::array<std::atomic<uint64_t>, Count> counters;
+    };
+
+  public:
+    /**
+     * \brief Adds value to the counter of a given index
+     */
+    void add(size_t index, uint64_t value = 1) noexcept;
+
+    /**
+     * \brief Returns the sum of the counter of a given index across all shards
+     * \details Increments made concurrently may or may not be observed
+     */
+    uint64_t load(size_t index) const noexcept;
+
+  private:
+    PerThreadArray<Shard> m_shards;
+  };
+
+}
+
+#include <utility/sharded_counters.hpp>
@@ -0,0 +1,25 @@
+#pragma once
+
+namespace utility
+{
+
+  template <size_t Count>
+  void ShardedCounters<Count>::add(size_t index, uint64_t value) noexcept
+  {
+    m_shards.local().counters[index].fetch_add(value, std::memory_order_relaxed);
+  }
+
+  template <size_t Count>
+  uint64_t ShardedCounters<Count>::load(size_t index) const noexcept
+  {
+    uint64_t result = 0;
+
+    for (size_t i = 0; i < m_shards.size(); ++i)
+    {
+      result += m_shards[i].counters[index].load(std::memory_order_relaxed);
+    }
+
+    return result;
+  }
+
+}
@@ -0,0 +1,253 @@
+#include <epoch.h>
+
+#include <per_thread_array.h>
+#include <sharded_counters.h>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <mutex>
+#include <vector>
+
+namespace utility
+{
+
+  class EpochDomain::Impl
+  {
+  private:
+    static constexpr size_t EpochCount = 3;
+    static constexpr size_t CollectStep = 64;
+    static constexpr uint64_t Decrement = ~uint64_t(0);
+
+    // objects retired by the threads of a slot, by epoch of retirement
+    struct Slot
+    {
+      std::mutex mutex;
+      std::array<std::vector<std::shared_ptr<const void>>, EpochCount> retired;
+      size_t count = 0;
+      size_t sinceCollect = 0;
+    };
+
+  public:
+    Impl()
+      : m_epoch(0)
+    {
+    }
+
+    size_t pin() noexcept
+    {
+      for (;;)
+      {
+        auto epoch = m_epoch.load();
+        m_pins.add(epoch % EpochCount);
+
+        // the pin must be visible to advancing threads before the epoch is checked again
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (m_epoch.load() == epoch)
+        {
+          return epoch % EpochCount;
+        }
+
+        // the epoch advanced meanwhile, so the pin may have been missed
+        unpin(epoch % EpochCount);
+      }
+    }
+
+    void unpin(size_t epoch) noexcept
+    {
+      // counters are summed across threads, so a guard may be released by another thread than the pinning one
+      std::atomic_thread_fence(std::memory_order_release);
+      m_pins.add(epoch, Decrement);
+    }
+
+    void retire(std::shared_ptr<const void>&& object)
+    {
+      if (!object)
+      {
+        return;
+      }
+
+      bool collectDue = false;
+
+      {
+        // each thread retires to its own slot, so writers only contend when collecting
+        auto& current = m_slots.local();
+        std::lock_guard<std::mutex> lock(current.mutex);
+
+        // the epoch is read under the lock of the slot, so an advance cannot release the list in between
+        current.retired[m_epoch.load() % EpochCount].push_back(std::move(object));
+        ++current.count;
+
+        if (++current.sinceCollect >= CollectStep)
+        {
+          current.sinceCollect = 0;
+          collectDue = true;
+        }
+      }
+
+      if (collectDue)
+      {
+        collect();
+      }
+    }
+
+    size_t collect()
+    {
+      // released objects are destroyed after the locks are released
+      std::vector<std::shared_ptr<const void>> released;
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // objects retired before the call are released after two advances
+        for (size_t i = 0; i + 1 < EpochCount; ++i)
+        {
+          if (!advance(released))
+          {
+            break;
+          }
+        }
+      }
+
+      return released.size();
+    }
+
+    size_t retired()
+    {
+      size_t result = 0;
+
+      for (size_t i = 0; i < m_slots.size(); ++i)
+      {
+        auto& current = m_slots[i];
+        std::lock_guard<std::mutex> lock(current.mutex);
+
+        result += current.count;
+      }
+
+      return result;
+    }
+
+  private:
+    bool advance(std::vector<std::shared_ptr<const void>>& released)
+    {
+      auto epoch = m_epoch.load();
+
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      // readers of the previous epoch may still reference objects retired during it
+      if (m_pins.load((epoch + EpochCount - 1) % EpochCount) != 0)
+      {
+        return false;
+      }
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      m_epoch.store(epoch + 1);
+
+      // readers pinned since the previous epoch started cannot reference objects retired during the one before it
+      for (size_t i = 0; i < m_slots.size(); ++i)
+      {
+        auto& current = m_slots[i];
+        std::lock_guard<std::mutex> lock(current.mutex);
+
+        auto& retired = current.retired[(epoch + EpochCount - 1) % EpochCount];
+        current.count -= retired.size();
+        std::move(retired.begin(), retired.end(), std::back_inserter(released));
+        retired.clear();
+      }
+
+      return true;
+    }
+
+  private:
+    std::atomic<size_t> m_epoch;
+    ShardedCounters<EpochCount> m_pins;
+    std::mutex m_mutex;  ///< serializes advances
+    PerThreadArray<Slot> m_slots;
+  };
+
+  constexpr size_t EpochDomain::Impl::EpochCount;
+  constexpr size_t EpochDomain::Impl::CollectStep;
+  constexpr uint64_t EpochDomain::Impl::Decrement;
+
+  EpochDomain::Guard::Guard() noexcept
+    : m_domain(nullptr)
+    , m_epoch(0)
+  {
+  }
+
+  EpochDomain::Guard::Guard(const EpochDomain* domain, size_t epoch) noexcept
+    : m_domain(domain)
+    , m_epoch(epoch)
+  {
+  }
+
+  EpochDomain::Guard::Guard(Guard&& other) noexcept
+    : m_domain(other.m_domain)
+    , m_epoch(other.m_epoch)
+  {
+    other.m_domain = nullptr;
+  }
+
+  EpochDomain::Guard& EpochDomain::Guard::operator=(Guard&& other) noexcept
+  {
+    if (this != &other)
+    {
+      reset();
+
+      m_domain = other.m_domain;
+      m_epoch = other.m_epoch;
+      other.m_domain = nullptr;
+    }
+
+    return *this;
+  }
+
+  EpochDomain::Guard::~Guard()
+  {
+    reset();
+  }
+
+  bool EpochDomain::Guard::pins(const EpochDomain& domain) const noexcept
+  {
+    return m_domain == &domain;
+  }
+
+  void EpochDomain::Guard::reset() noexcept
+  {
+    if (m_domain)
+    {
+      m_domain->m_impl->unpin(m_epoch);
+      m_domain = nullptr;
+    }
+  }
+
+  EpochDomain::EpochDomain()
+    : m_impl(std::make_unique<Impl>())
+  {
+  }
+
+  EpochDomain::~EpochDomain() = default;
+
+  EpochDomain::Guard EpochDomain::pin() const noexcept
+  {
+    return Guard(this, m_impl->pin());
+  }
+
+  void EpochDomain::retire(std::shared_ptr<const void> object)
+  {
+    m_impl->retire(std::move(object));
+  }
+
+  size_t EpochDomain::collect()
+  {
+    return m_impl->collect();
+  }
+
+  size_t EpochDomain::retired() const
+  {
+    return m_impl->retired();
+  }
+
+}
@@ -0,0 +1,169 @@
+#include <lock_profile.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace utility
+{
+
+  namespace
+  {
+
+    using LockProfiles = std::map<std::string, std::unique_ptr<LockProfile>>;
+
+    std::mutex& lock_profiles_mutex()
+    {
+      static std::mutex mutex;
+      return mutex;
+    }
+
+    LockProfiles& lock_profiles()
+    {
+      static LockProfiles profiles;
+      return profiles;
+    }
+
+    void print_times(std::ostream& stream, const char* title, const Histogram& times)
+    {
+      stream
+        << "  " << title << " (ns):"
+        << " mean = " << static_cast<uint64_t>(times.mean())
+        << ", p50 = " << times.percentile(.5)
+        << ", p99 = " << times.percentile(.99)
+        << ", p999 = " << times.percentile(.999)
+        << ", max = " << times.percentile(1.)
+        << std::endl;
+    }
+
+  }
+
+  struct LockProfile::Shard
+  {
+    ConcurrentHistogram waitTimes;
+    ConcurrentHistogram holdTimes;
+    std::atomic<uint64_t> contended;
+    std::atomic<uint64_t> uncontended;
+  };
+
+  LockProfile::LockProfile(const std::string& name)
+    : m_name(name)
+  {
+  }
+
+  LockProfile::~LockProfile() = default;
+
+  void LockProfile::record_acquisition(uint64_t wait, bool contended) noexcept
+  {
+    auto& current = m_shards.local();
+
+    if (contended)
+    {
+      current.contended.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+      current.uncontended.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    current.waitTimes.record(wait);
+  }
+
+  void LockProfile::record_hold(uint64_t hold) noexcept
+  {
+    m_shards.local().holdTimes.record(hold);
+  }
+
+  const std::string& LockProfile::name() const noexcept
+  {
+    return m_name;
+  }
+
+  Histogram LockProfile::wait_times() const noexcept
+  {
+    Histogram result;
+
+    for (size_t i = 0; i < m_shards.size(); ++i)
+    {
+      result.merge(m_shards[i].waitTimes);
+    }
+
+    return result;
+  }
+
+  Histogram LockProfile::hold_times() const noexcept
+  {
+    Histogram result;
+
+    for (size_t i = 0; i < m_shards.size(); ++i)
+    {
+      result.merge(m_shards[i].holdTimes);
+    }
+
+    return result;
+  }
+
+  uint64_t LockProfile::contended() const noexcept
+  {
+    uint64_t result = 0;
+
+    for (size_t i = 0; i < m_shards.size(); ++i)
+    {
+      result += m_shards[i].contended.load(std::memory_order_relaxed);
+    }
+
+    return result;
+  }
+
+  uint64_t LockProfile::uncontended() const noexcept
+  {
+    uint64_t result = 0;
+
+    for (size_t i = 0; i < m_shards.size(); ++i)
+    {
+      result += m_shards[i].uncontended.load(std::memory_order_relaxed);
+    }
+
+    return result;
+  }
+
+  void LockProfile::print(std::ostream& stream) const
+  {
+    auto contended = this->contended();
+    auto total = contended + uncontended();
+
+    stream
+      << "Lock '" << m_name << "': "
+      << total << " acquisitions, "
+      << contended << " contended"
+      << std::endl;
+
+    print_times(stream, "wait", wait_times());
+    print_times(stream, "hold", hold_times());
+  }
+
+  LockProfile& lock_profile(const std::string& name)
+  {
+    std::lock_guard<std::mutex> lock(lock_profiles_mutex());
+
+    auto& profile = lock_profiles()[name];
+    if (!profile)
+    {
+      profile.reset(new LockProfile(name));
+    }
+
+    return *profile;
+  }
+
+  void print_lock_profiles(std::ostream& stream)
+  {
+    std::lock_guard<std::mutex> lock(lock_profiles_mutex());
+
+    for (const auto& profile : lock_profiles())
+    {
+      profile.second->print(stream);
+    }
+  }
+
+}
@@ -0,0 +1,135 @@
+#include <mapped_file.h>
+
+#include <exceptions.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define UTILITY_MAPPED_FILE_MMAP
+#else
+#include <fstream>
+#include <iterator>
+#include <vector>
+#endif
+
+namespace utility
+{
+
+#ifdef UTILITY_MAPPED_FILE_MMAP
+
+  class MappedFile::Impl
+  {
+  public:
+    explicit Impl(const std::string& path) try
+      : m_data(nullptr)
+      , m_size(0)
+    {
+      auto fd = open(path.c_str(), O_RDONLY);
+      THROW_IF(fd < 0, "Could not open file = ", path);
+
+      struct stat status;
+      if (fstat(fd, &status) != 0)
+      {
+        close(fd);
+        THROW("Could not get the size of file = ", path);
+      }
+
+      m_size = static_cast<size_t>(status.st_size);
+
+      if (m_size != 0)
+      {
+        auto data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+          close(fd);
+          THROW("Could not map file = ", path);
+        }
+
+        m_data = static_cast<const char*>(data);
+        madvise(data, m_size, MADV_SEQUENTIAL);
+      }
+
+      close(fd);
+    }
+    catch (...)
+    {
+      RETHROW("Failed to construct a MappedFile!");
+    }
+
+    ~Impl()
+    {
+      if (m_data != nullptr)
+      {
+        munmap(const_cast<char*>(m_data), m_size);
+      }
+    }
+
+    const char* data() const noexcept
+    {
+      return m_data;
+    }
+
+    size_t size() const noexcept
+    {
+      return m_size;
+    }
+
+  private:
+    const char* m_data;
+    size_t m_size;
+  };
+
+#else
+
+  class MappedFile::Impl
+  {
+  public:
+    explicit Impl(const std::string& path) try
+    {
+      std::ifstream in(path, std::ios_base::binary);
+      THROW_IF(!in.good(), "Could not open file = ", path);
+
+      m_data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+      THROW_IF(in.bad(), "Could not read file = ", path);
+    }
+    catch (...)
+    {
+      RETHROW("Failed to construct a MappedFile!");
+    }
+
+    const char* data() const noexcept
+    {
+      return m_data.data();
+    }
+
+    size_t size() const noexcept
+    {
+      return m_data.size();
+    }
+
+  private:
+    std::vector<char> m_data;
+  };
+
+#endif
+
+  MappedFile::MappedFile(const std::string& path)
+    : m_impl(std::make_unique<Impl>(path))
+  {
+  }
+
+  const char* MappedFile::data() const noexcept
+  {
+    return m_impl->data();
+  }
+
+  size_t MappedFile::size() const noexcept
+  {
+    return m_impl->size();
+  }
+
+  MappedFile::~MappedFile() = default;
+
+}
@@ -0,0 +1,264 @@
+#include <numa.h>
+
+#include <algorithm>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define UTILITY_NUMA_LINUX
+#endif
+
+namespace utility
+{
+
+  namespace
+  {
+
+    // parses lists such as "0-3,8,10-11" used by sysfs
+    std::vector<size_t> parse_list(const std::string& list)
+    {
+      std::vector<size_t> result;
+
+      std::istringstream in(list);
+      std::string range;
+      while (std::getline(in, range, ','))
+      {
+        auto dash = range.find('-');
+
+        try
+        {
+          auto first = std::stoul(range.substr(0, dash));
+          auto last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+
+          for (auto i = first; i <= last; ++i)
+          {
+            result.push_back(i);
+          }
+        }
+        catch (...)
+        {
+          return std::vector<size_t>();
+        }
+      }
+
+      return result;
+    }
+
+    std::vector<size_t> read_list(const std::string& path)
+    {
+      std::ifstream in(path);
+
+      std::string list;
+      if (!std::getline(in, list))
+      {
+        return std::vector<size_t>();
+      }
+
+      return parse_list(list);
+    }
+
+    size_t page_size() noexcept
+    {
+#ifdef UTILITY_NUMA_LINUX
+      auto size = sysconf(_SC_PAGESIZE);
+      return size > 0 ? static_cast<size_t>(size) : 4096;
+#else
+      return 4096;
+#endif
+    }
+
+    size_t round_to_pages(size_t bytes) noexcept
+    {
+      auto pageSize = page_size();
+      return (bytes + pageSize - 1) / pageSize * pageSize;
+    }
+
+  }
+
+  size_t numa_node_count() noexcept
+  {
+    static const size_t count = []
+    {
+      try
+      {
+        auto nodes = read_list("/sys/devices/system/node/online");
+        return nodes.empty() ? size_t(1) : nodes.back() + 1;
+      }
+      catch (...)
+      {
+        return size_t(1);
+      }
+    }();
+
+    return count;
+  }
+
+  size_t numa_current_node() noexcept
+  {
+#if defined(UTILITY_NUMA_LINUX) && defined(SYS_getcpu)
+    unsigned cpu = 0;
+    unsigned node = 0;
+
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 && node < numa_node_count())
+    {
+      return node;
+    }
+#endif
+
+    return 0;
+  }
+
+  bool numa_bind_thread(size_t node) noexcept
+  {
+#ifdef UTILITY_NUMA_LINUX
+    try
+    {
+      auto cpus = read_list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+      if (cpus.empty())
+      {
+        return false;
+      }
+
+      cpu_set_t set;
+      CPU_ZERO(&set);
+
+      for (auto cpu : cpus)
+      {
+        if (cpu < CPU_SETSIZE)
+        {
+          CPU_SET(cpu, &set);
+        }
+      }
+
+      return sched_setaffinity(0, sizeof(set), &set) == 0;
+    }
+    catch (...)
+    {
+      return false;
+    }
+#else
+    return false;
+#endif
+  }
+
+  void* numa_allocate(size_t bytes, size_t node)
+  {
+#ifdef UTILITY_NUMA_LINUX
+    auto size = round_to_pages(bytes);
+
+    auto ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED)
+    {
+      throw std::bad_alloc();
+    }
+
+#ifdef SYS_mbind
+    const int MemoryPolicyPreferred = 1;
+    const size_t maskBits = sizeof(unsigned long) * 8;
+
+    if (numa_node_count() > 1 && node < maskBits)
+    {
+      unsigned long mask = 1ul << node;
+
+      // placement is best effort: memory stays usable (on any node) if the kernel refuses the policy
+      syscall(SYS_mbind, ptr, size, MemoryPolicyPreferred, &mask, maskBits, 0);
+    }
+#endif
+
+    return ptr;
+#else
+    return ::operator new(round_to_pages(bytes));
+#endif
+  }
+
+  void numa_free(void* ptr, size_t bytes) noexcept
+  {
+#ifdef UTILITY_NUMA_LINUX
+    munmap(ptr, round_to_pages(bytes));
+#else
+    ::operator delete(ptr);
+#endif
+  }
+
+  NumaArena::NumaArena(size_t node)
+    : m_node(node)
+    , m_freeBlocks(MaxBlockSize / BlockAlignment, nullptr)
+    , m_next(nullptr)
+    , m_end(nullptr)
+  {
+  }
+
+  void* NumaArena::allocate(size_t bytes)
+  {
+    if (bytes > MaxBlockSize)
+    {
+      return numa_allocate(bytes, m_node);
+    }
+
+    auto sizeClass = (std::max(bytes, size_t(1)) + BlockAlignment - 1) / BlockAlignment - 1;
+    auto blockSize = (sizeClass + 1) * BlockAlignment;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto& freeBlock = m_freeBlocks[sizeClass];
+    if (freeBlock != nullptr)
+    {
+      auto block = freeBlock;
+      freeBlock = block->next;
+
+      return block;
+    }
+
+    if (static_cast<size_t>(m_end - m_next) < blockSize)
+    {
+      m_chunks.reserve(m_chunks.size() + 1);
+
+      m_next = static_cast<char*>(numa_allocate(ChunkSize, m_node));
+      m_end = m_next + ChunkSize;
+
+      m_chunks.push_back(m_next);
+    }
+
+    auto block = m_next;
+    m_next += blockSize;
+
+    return block;
+  }
+
+  void NumaArena::deallocate(void* ptr, size_t bytes) noexcept
+  {
+    if (bytes > MaxBlockSize)
+    {
+      numa_free(ptr, bytes);
+      return;
+    }
+
+    auto sizeClass = (std::max(bytes, size_t(1)) + BlockAlignment - 1) / BlockAlignment - 1;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto block = static_cast<FreeBlock*>(ptr);
+    block->next = m_freeBlocks[sizeClass];
+    m_freeBlocks[sizeClass] = block;
+  }
+
+  size_t NumaArena::node() const noexcept
+  {
+    return m_node;
+  }
+
+  NumaArena::~NumaArena()
+  {
+    for (auto chunk : m_chunks)
+    {
+      numa_free(chunk, ChunkSize);
+    }
+  }
+
+}
@@ -0,0 +1,16 @@
+#include <per_thread_array.h>
+
+#include <atomic>
+
+namespace utility
+{
+
+  size_t thread_index() noexcept
+  {
+    static std::atomic<size_t> next(0);
+    thread_local const size_t index = next.fetch_add(1, std::memory_order_relaxed);
+
+    return index;
+  }
+
+}
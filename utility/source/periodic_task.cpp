@@ -0,0 +1,85 @@
+#include <periodic_task.h>
+
+#include <exceptions.h>
+
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace utility
+{
+
+  class PeriodicTask::Impl
+  {
+  public:
+    Impl(std::chrono::milliseconds interval, const Task& task) try
+      : m_interval(interval)
+      , m_task(task)
+      , m_stop(false)
+    {
+      THROW_IF(m_interval.count() <= 0, "Interval = ", m_interval.count(), "ms is not positive!");
+
+      m_thread = std::thread([this] { run(); });
+    }
+    catch (...)
+    {
+      RETHROW("Failed to construct a PeriodicTask!");
+    }
+
+    ~Impl()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+      }
+
+      m_condition.notify_all();
+      m_thread.join();
+    }
+
+  private:
+    void run() noexcept
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+
+      while (!m_condition.wait_for(lock, m_interval, [this] { return m_stop; }))
+      {
+        lock.unlock();
+
+        try
+        {
+          m_task();
+        }
+        catch (const std::exception& e)
+        {
+          std::cerr << "Exception in periodic task!" << std::endl;
+
+          print_exception(e);
+        }
+        catch (...)
+        {
+          std::cerr << "Unknown exception in periodic task!" << std::endl;
+        }
+
+        lock.lock();
+      }
+    }
+
+  private:
+    const std::chrono::milliseconds m_interval;
+    const Task m_task;
+    bool m_stop;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::thread m_thread;
+  };
+
+  PeriodicTask::PeriodicTask(std::chrono::milliseconds interval, const Task& task)
+    : m_impl(std::make_unique<Impl>(interval, task))
+  {
+  }
+
+  PeriodicTask::~PeriodicTask() = default;
+
+}
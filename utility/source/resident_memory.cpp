@@ -0,0 +1,39 @@
+#include <resident_memory.h>
+
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace utility
+{
+
+  size_t resident_memory() noexcept
+  {
+#if defined(__linux__)
+    try
+    {
+      std::ifstream in("/proc/self/statm");
+
+      size_t total = 0;
+      size_t resident = 0;
+      if (!(in >> total >> resident))
+      {
+        return 0;
+      }
+
+      auto pageSize = sysconf(_SC_PAGESIZE);
+
+      return pageSize > 0 ? resident * static_cast<size_t>(pageSize) : 0;
+    }
+    catch (...)
+    {
+      return 0;
+    }
+#else
+    return 0;
+#endif
+  }
+
+}